@@ -0,0 +1,117 @@
+// Compares the bracketing methods: number of function evaluations, time per
+// solve, and |f| at the root found, on a set of classic test functions.
+#include "../include/calculisto/root_finding/bracketing.hpp"
+    using namespace calculisto::root_finding;
+#include <fmt/format.h>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <string>
+
+    struct
+problem_t
+{
+        std::string
+    name;
+        std::function <double (double)>
+    function;
+        double
+      a
+    , b
+    ;
+};
+
+    auto const
+problems = std::vector <problem_t>
+{
+      { "cos (x) - x^3",        [](double x){ return std::cos (x) - x * x * x; },        0.,  10. }
+    , { "x^3 - 2 x - 5",        [](double x){ return x * x * x - 2. * x - 5.; },         2.,  3.  }
+    , { "sin (x) - x / 2",      [](double x){ return std::sin (x) - x / 2.; },           std::numbers::pi / 2., std::numbers::pi }
+    , { "exp (x) - 1e3",        [](double x){ return std::exp (x) - 1e3; },              -10., 10. }
+    , { "(x - 1) exp (-x)",     [](double x){ return (x - 1.) * std::exp (-x); },        0.,  1.5 }
+    , { "tanh (50 (x - 0.3))",  [](double x){ return std::tanh (50. * (x - 0.3)); },     0.,  1.  }
+    , { "x^9",                  [](double x){ return std::pow (x, 9.); },                -1., 4.  }
+    , { "1 / x - 0.3",          [](double x){ return 1. / x - 0.3; },                    0.1, 10. }
+};
+
+    constexpr auto
+tolerance = 1e-12;
+
+// Large enough for every method to converge on every problem.
+    constexpr auto
+max_iter = 1000;
+
+// Number of evaluations, time per solve in ns, and error.
+    template <class Method>
+    auto
+measure (Method method, problem_t const& p)
+{
+        auto
+    count = 0;
+        auto
+    counted = [&](double x){ ++count; return p.function (x); };
+        double
+    root;
+    try
+    {
+        root = method (counted, p.a, p.b);
+    }
+    catch (...)
+    {
+        return std::tuple { -1, 0., 0. };
+    }
+        const auto
+    evaluations = count;
+        constexpr auto
+    repeat = 2000;
+        const auto
+    start = std::chrono::steady_clock::now ();
+    for (auto i = 0; i < repeat; ++i)
+    {
+        root += method (p.function, p.a, p.b) * 1e-300;
+    }
+        const auto
+    ns = std::chrono::duration <double, std::nano> (std::chrono::steady_clock::now () - start).count () / repeat;
+    return std::tuple { evaluations, ns, std::fabs (p.function (root)) };
+}
+
+    int
+main ()
+{
+        auto const
+    converged = make_zhang_simple_converged (tolerance);
+        auto const
+    methods = std::vector <std::pair <std::string, std::function <double (std::function <double (double)> const&, double, double)>>>
+    {
+          { "zhang",        [&](auto const& f, double a, double b){ return zhang (f, a, b, { .max_iter = max_iter, .converged = converged }); } }
+        , { "itp",          [&](auto const& f, double a, double b){ return itp (f, a, b, { .max_iter = max_iter, .converged = converged, .tolerance = tolerance / 2 }); } }
+        , { "chandrupatla", [&](auto const& f, double a, double b){ return chandrupatla (f, a, b, { .max_iter = max_iter, .converged = converged }); } }
+        , { "toms748",      [&](auto const& f, double a, double b){ return toms748 (f, a, b, { .max_iter = max_iter, .converged = converged }); } }
+    };
+    fmt::print ("{:<22}", "evaluations, time, |f|");
+    for (auto const& [ name, method ]: methods)
+    {
+        fmt::print ("{:>25}", name);
+    }
+    fmt::print ("\n");
+        auto
+    total = std::vector <int> (methods.size ());
+    for (auto const& p: problems)
+    {
+        fmt::print ("{:<22}", p.name);
+        for (auto i = 0u; i < methods.size (); ++i)
+        {
+                auto const
+            [ evaluations, ns, error ] = measure (methods[i].second, p);
+            total[i] += evaluations;
+            fmt::print ("{:>6} {:>6.0f} ns {:>8.1e}", evaluations, ns, error);
+        }
+        fmt::print ("\n");
+    }
+    fmt::print ("{:<22}", "total");
+    for (auto t: total)
+    {
+        fmt::print ("{:>6}{:19}", t, "");
+    }
+    fmt::print ("\n");
+}
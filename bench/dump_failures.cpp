@@ -0,0 +1,48 @@
+// Lists the records of a failure log (failure_log.hpp): the solver, the
+// inputs, and the first and last rows of the convergence history. To replay
+// them, see replay_failures.
+#include "../include/calculisto/root_finding/failure_log.hpp"
+    using namespace calculisto::root_finding;
+#include <fmt/format.h>
+
+    auto
+row_string (std::span <double const> row)
+{
+        auto
+    s = std::string {};
+    for (auto x: row)
+    {
+        s += fmt::format ("{}{:.17g}", s.empty () ? "" : " ", x);
+    }
+    return s;
+}
+
+    int
+main (int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fmt::print (stderr, "Usage: {} FILE\n", argv[0]);
+        return 2;
+    }
+    try
+    {
+            const auto
+        log = mapped_failure_log_t { argv[1] };
+        for (auto const& record: log.records ())
+        {
+            fmt::print ("{}: inputs [{}], {} rows\n", record.solver, row_string (record.inputs), record.rows);
+            if (record.rows > 0)
+            {
+                fmt::print ("    first: {}\n", row_string (record.row (0)));
+                fmt::print ("    last:  {}\n", row_string (record.row (record.rows - 1)));
+            }
+        }
+        fmt::print ("{} records\n", log.records ().size ());
+    }
+    catch (failure_log_bad_file_e const&)
+    {
+        fmt::print (stderr, "{}: not a failure log\n", argv[1]);
+        return 1;
+    }
+}
@@ -2,6 +2,6 @@ DEPENDENCIES_HEADERS= \
 
 PROJECT=root_finding
 LINK.o=${LINK.cc}
-CXXFLAGS+=-std=c++2a -Wall -Wextra $(foreach dir, ${DEPENDENCIES_HEADERS}, -I../${dir})
+CXXFLAGS+=-std=c++2a -pthread -Wall -Wextra $(foreach dir, ${DEPENDENCIES_HEADERS}, -I../${dir})
 LDLIBS+= -lfmt
 
@@ -0,0 +1,349 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// All the roots in an interval: the interval is sampled, the sign changes are
+// isolated by adaptive subdivision, and each is refined with zhang. The
+// subintervals are processed in parallel, so the function must be safe to call
+// from several threads.
+//
+// Without more information, a subinterval without a sign change is subdivided
+// when |f| dips in its middle, or when the parabola through its ends and its
+// middle has roots, which reveals most pairs of close roots. With a
+// Lipschitz bound L on f (i.e. |f'| <= L), a subinterval [x0, x1] can be
+// discarded as soon as |f (x0)| + |f (x1)| > L (x1 - x0), and is subdivided
+// otherwise: no pair of roots further apart than (b - a) / samples / 2^max_depth
+// is then missed.
+    struct
+AllRootsTag
+{};
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+all_roots_options_t
+{
+    // Number of initial subintervals.
+        int
+    samples = 64;
+    // Maximum number of subdivisions of an initial subinterval.
+        int
+    max_depth = 10;
+    // Bound on |f'|, if known (0 otherwise).
+        FunctionResult
+    lipschitz = 0;
+        unsigned
+    threads = default_thread_count ();
+    // Its observer, if any, is called from the threads.
+        zhang_options_t <Value, FunctionResult>
+    zhang_options = {};
+    // At each evaluation of the sampling, the iteration being the depth of the
+    // subdivision, once they all are.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    namespace
+info::data
+{
+        struct
+    all_roots_iterations_t
+        : base_iterations_t
+    {
+        // Number of function evaluations for the sampling, and number of
+        // brackets refined with zhang (iteration_count is the sum of their
+        // iteration counts).
+            int
+        evaluation_count = 0;
+            int
+        bracket_count = 0;
+    };
+
+        template <class Value, class FunctionResult>
+        struct
+    all_roots_convergence_t
+        : all_roots_iterations_t
+    {
+        // The brackets found, with the function values at their ends.
+            std::vector <std::tuple <Value, Value, FunctionResult, FunctionResult>>
+        brackets;
+    };
+
+        template <class... Ts>
+        struct
+    select <AllRootsTag, tag::iterations, Ts...>
+    {
+            using
+        type = all_roots_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <AllRootsTag, tag::convergence, Function, Value>
+    {
+            using
+        type = all_roots_convergence_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+all_roots (
+      Function&& function
+    , Value      a
+    , Value      b
+    , all_roots_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+        constexpr static auto
+    observed = !std::is_same_v <Observer, no_observer_t>;
+
+        using
+    info_data_t = info::data::select_t <
+          AllRootsTag
+        , InfoTag
+        , Function
+        , Value
+    >;
+        [[maybe_unused]]
+        auto
+    info_data = info_data_t {};
+
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        const auto
+    n = static_cast <std::size_t> (std::max (options.samples, 1));
+        auto
+    x = std::vector <Value> (n + 1);
+        auto
+    fx = std::vector <FunctionResult> (n + 1);
+    // What each subinterval finds.
+        struct
+    found_t
+    {
+            std::vector <Value>
+        roots;
+            std::remove_const_t <info_data_t>
+        info;
+        // The evaluations of the subdivision, for the observer: x, f, depth.
+            std::vector <std::tuple <Value, FunctionResult, int>>
+        samples;
+    };
+        auto
+    found = std::vector <found_t> (n);
+        auto
+    process = [&](std::size_t i)
+    {
+            auto&
+        [ roots, in, samples ] = found[i];
+            auto
+        evaluate = [&](Value const& v, int depth)
+        {
+            if constexpr (need_info)
+            {
+                ++in.evaluation_count;
+            }
+                const auto
+            f = FunctionResult (function (v));
+            if constexpr (observed)
+            {
+                samples.push_back ({ v, f, depth });
+            }
+            return f;
+        };
+            auto
+        refine = [&](Value x0, Value x1, FunctionResult f0, FunctionResult f1)
+        {
+            if constexpr (need_info)
+            {
+                ++in.bracket_count;
+                if constexpr (need_info_convergence)
+                {
+                    in.brackets.push_back ({ x0, x1, f0, f1 });
+                }
+                    auto
+                [ r, zi ] = zhang (function, x0, x1, options.zhang_options, info::iterations);
+                in.iteration_count += zi.iteration_count;
+                in.converged = in.converged && zi.converged;
+                in.function_threw = in.function_threw || zi.function_threw;
+                roots.push_back (r);
+            }
+            else
+            {
+                roots.push_back (zhang (function, x0, x1, options.zhang_options));
+            }
+        };
+        // Depth first, left first, so that the roots come out sorted. The
+        // roots at the ends are dealt with by the caller.
+            auto
+        sign_change = [](FunctionResult const& u, FunctionResult const& v)
+        {
+            return u != 0 && v != 0 && (u < 0) != (v < 0);
+        };
+            auto
+        subdivide = [&](
+              auto& self
+            , Value x0
+            , Value x1
+            , FunctionResult f0
+            , FunctionResult f1
+            , int depth
+        ) -> void
+        {
+            if (sign_change (f0, f1))
+            {
+                return refine (x0, x1, f0, f1);
+            }
+            if (depth >= options.max_depth)
+            {
+                return;
+            }
+                using std::fabs;
+            if (options.lipschitz > 0 && fabs (f0) + fabs (f1) > options.lipschitz * (x1 - x0))
+            {
+                return;
+            }
+                const auto
+            xm = (x0 + x1) / 2;
+                const auto
+            fm = evaluate (xm, depth + 1);
+            // The parabola through the three points, fm + B t + A t^2 on
+            // [-1, 1]: does its extremum cross zero?
+                const auto
+            A = (f0 + f1) / 2 - fm;
+                const auto
+            B = (f1 - f0) / 2;
+                const auto
+            t = A != 0 ? -B / (2 * A) : FunctionResult (2);
+                const auto
+            vertex = fm + B * t / 2;
+                const auto
+            parabola_crosses = fabs (t) < 1 && (vertex == 0 || sign_change (fm, vertex));
+            if (
+                   options.lipschitz > 0
+                || fm == 0
+                || sign_change (f0, fm)
+                || sign_change (fm, f1)
+                || fabs (fm) < std::min (fabs (f0), fabs (f1))
+                || parabola_crosses
+            ){
+                self (self, x0, xm, f0, fm, depth + 1);
+                if (fm == 0)
+                {
+                    roots.push_back (xm);
+                }
+                self (self, xm, x1, fm, f1, depth + 1);
+            }
+        };
+        if (fx[i] == 0)
+        {
+            roots.push_back (x[i]);
+        }
+        subdivide (subdivide, x[i], x[i + 1], fx[i], fx[i + 1], 0);
+    };
+    try
+    {
+        parallel_for (n + 1, options.threads, [&](std::size_t i)
+        {
+            x[i] = i == n ? b : a + (b - a) * static_cast <Value> (i) / static_cast <Value> (n);
+            fx[i] = function (x[i]);
+        });
+        if constexpr (need_info)
+        {
+            info_data.evaluation_count = static_cast <int> (n + 1);
+        }
+        for (auto i = 0u; i <= n; ++i)
+        {
+            options.observer (iteration_event_t <Value, FunctionResult> {
+                "all_roots", 0, step_t::initial, x[i], fx[i]
+            });
+        }
+        parallel_for (n, options.threads, process);
+        for (auto const& f: found)
+        {
+            for (auto const& [ v, fv, depth ]: f.samples)
+            {
+                options.observer (iteration_event_t <Value, FunctionResult> {
+                    "all_roots", depth, step_t::sampling, v, fv
+                });
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { std::vector <Value> {}, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+        auto
+    roots = std::vector <Value> {};
+    if constexpr (need_info)
+    {
+        info_data.iteration_count = 0;
+    }
+    for (auto& [ r, in, samples ]: found)
+    {
+        roots.insert (roots.end (), r.begin (), r.end ());
+        if constexpr (need_info)
+        {
+            info_data.iteration_count += in.iteration_count;
+            info_data.evaluation_count += in.evaluation_count;
+            info_data.bracket_count += in.bracket_count;
+            info_data.converged = info_data.converged && in.converged;
+            info_data.function_threw = info_data.function_threw || in.function_threw;
+            if constexpr (need_info_convergence)
+            {
+                info_data.brackets.insert (info_data.brackets.end (), in.brackets.begin (), in.brackets.end ());
+            }
+        }
+    }
+    if (fx[n] == 0)
+    {
+        roots.push_back (b);
+    }
+    std::sort (roots.begin (), roots.end ());
+    if constexpr (need_info)
+    {
+        return std::pair { roots, info_data };
+    }
+    else
+    {
+        return roots;
+    }
+}
+} // namespace calculisto::root_finding
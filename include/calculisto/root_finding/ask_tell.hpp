@@ -0,0 +1,419 @@
+#pragma once
+#include "root_finding.hpp"
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Step-wise, resumable, solvers: instead of calling the function, they ask for
+// the point where they want it evaluated, and are told the result. The
+// function is thus evaluated by the caller, when and how it wants, e.g. for the
+// pending points of many solves at once. They do exactly what the blocking
+// solvers do, with the same options, and their info is the info::iterations
+// one.
+//
+//     auto s = newton_solver_t { 1. };
+//     while (!s.done ())
+//     {
+//         auto x = s.ask ();
+//         s.tell (f (x), df (x));
+//     }
+//     if (s.info ().converged) use (s.result ());
+    enum class
+solver_status_t
+{
+      running
+    , converged
+    , no_convergence
+    , zero_derivative
+    , no_single_root_between_brackets
+    // Told a NaN after the last backtrack.
+    , function_threw
+};
+
+//------------------------------------------------------------------------------
+// Newton
+    template <
+          class Value
+        , class FunctionResult = Value
+        , class DerivativeResult = FunctionResult
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+        )>
+    >
+    class
+newton_solver_t
+{
+        newton_options_t <Value, FunctionResult, DerivativeResult, Converged>
+    options;
+        Value
+    current;
+        int
+    iteration = 0;
+        solver_status_t
+    status_ = solver_status_t::running;
+    // The line search, with backtracking: current is past - t step, where f
+    // was f_past.
+        Value
+      past = {}
+    , step = {}
+    , t = 1
+    ;
+        FunctionResult
+    f_past = {};
+        int
+      backtracks = 0
+    , backtrack_count = 0
+    ;
+        bool
+    trial = false;
+
+        Value
+    project (Value const& x) const
+    {
+        return x < options.lower ? options.lower : options.upper < x ? options.upper : x;
+    }
+
+    public:
+    explicit
+    newton_solver_t (
+          Value const& initial_guess
+        , newton_options_t <Value, FunctionResult, DerivativeResult, Converged> const& options = {}
+    )
+        : options { options }
+        , current { initial_guess }
+    {
+        if (options.max_iter <= 0)
+        {
+            status_ = solver_status_t::no_convergence;
+        }
+    }
+
+        bool
+    done () const
+    {
+        return status_ != solver_status_t::running;
+    }
+
+    // Where to evaluate the function and its derivative next.
+        Value
+    ask () const
+    {
+        return current;
+    }
+
+    // With backtracking, tell a NaN where the function can't be evaluated.
+        void
+    tell (FunctionResult const& f, DerivativeResult const& df)
+    {
+        if (done ())
+        {
+            return;
+        }
+        if (trial)
+        {
+            if (
+                   backtracks < options.max_backtracks
+                && !(constexpr_fabs (f) <= (1 - options.armijo * t) * constexpr_fabs (f_past))
+            ){
+                t /= 2;
+                current = project (past - t * step);
+                ++backtracks;
+                ++backtrack_count;
+                return;
+            }
+            trial = false;
+            if (f != f)
+            {
+                status_ = solver_status_t::function_threw;
+                return;
+            }
+            if (options.converged (current, past, f_past))
+            {
+                status_ = solver_status_t::converged;
+                return;
+            }
+            if (++iteration >= options.max_iter)
+            {
+                status_ = solver_status_t::no_convergence;
+                return;
+            }
+        }
+        if (df == 0.)
+        {
+            status_ = solver_status_t::zero_derivative;
+            return;
+        }
+        past = current;
+        f_past = f;
+        step = f / df;
+        current = project (past - step);
+        if (current == past && past - step != past)
+        {
+            status_ = solver_status_t::no_convergence;
+            return;
+        }
+        if (options.backtracking)
+        {
+            trial = true;
+            t = 1;
+            backtracks = 0;
+            return;
+        }
+        if (options.converged (current, past, f))
+        {
+            status_ = solver_status_t::converged;
+            return;
+        }
+        if (++iteration >= options.max_iter)
+        {
+            status_ = solver_status_t::no_convergence;
+        }
+    }
+
+        solver_status_t
+    status () const
+    {
+        return status_;
+    }
+
+        Value
+    result () const
+    {
+        return current;
+    }
+
+        info::data::newton_iterations_t
+    info () const
+    {
+            auto
+        i = info::data::newton_iterations_t {};
+        i.converged = status_ == solver_status_t::converged;
+        i.zero_derivative = status_ == solver_status_t::zero_derivative;
+        i.function_threw = status_ == solver_status_t::function_threw;
+        i.iteration_count = iteration;
+        i.backtrack_count = backtrack_count;
+        return i;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Zhang
+    template <
+          class Value
+        , class FunctionResult = Value
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+    >
+    class
+zhang_solver_t
+{
+        zhang_options_t <Value, FunctionResult, Converged>
+    options;
+    // What it waits for.
+        enum class
+    stage_t
+    {
+          fa
+        , fb
+        , fc
+        , fs
+    };
+        stage_t
+    stage = stage_t::fa;
+        Value
+      a
+    , b
+    , c = {}
+    , s = {}
+    ;
+        FunctionResult
+      fa = {}
+    , fb = {}
+    , fc = {}
+    ;
+        int
+    iteration = 0;
+        solver_status_t
+    status_ = solver_status_t::running;
+
+    // Once fa and fb are known.
+        void
+    start ()
+    {
+        if (fa * fb > 0)
+        {
+            status_ = solver_status_t::no_single_root_between_brackets;
+        }
+        // An end of the bracket may be the root already.
+        else if (fa == 0 || fb == 0)
+        {
+            status_ = solver_status_t::converged;
+        }
+        else if (options.max_iter <= 0)
+        {
+            status_ = solver_status_t::no_convergence;
+        }
+        else
+        {
+            stage = stage_t::fc;
+            c = (a + b) / 2;
+        }
+    }
+
+    public:
+    zhang_solver_t (
+          Value a // bracket 1
+        , Value b // bracket 2
+        , zhang_options_t <Value, FunctionResult, Converged> const& options = {}
+    )
+        : options { options }
+        , a { std::min (a, b) }
+        , b { std::max (a, b) }
+    {}
+
+    // With the function values at the ends of the bracket already known, e.g.
+    // from bracket_root.
+    explicit
+    zhang_solver_t (
+          std::tuple <Value, Value, FunctionResult, FunctionResult> const& bracket
+        , zhang_options_t <Value, FunctionResult, Converged> const& options = {}
+    )
+        : options { options }
+    {
+        std::tie (a, b, fa, fb) = bracket;
+        if (b < a)
+        {
+                using std::swap;
+            swap (a, b);
+            swap (fa, fb);
+        }
+        start ();
+    }
+
+        bool
+    done () const
+    {
+        return status_ != solver_status_t::running;
+    }
+
+    // Where to evaluate the function next.
+        Value
+    ask () const
+    {
+        switch (stage)
+        {
+            case stage_t::fa: return a;
+            case stage_t::fb: return b;
+            case stage_t::fc: return c;
+            default:          return s;
+        }
+    }
+
+        void
+    tell (FunctionResult const& f)
+    {
+        if (done ())
+        {
+            return;
+        }
+        switch (stage)
+        {
+            case stage_t::fa:
+                fa = f;
+                stage = stage_t::fb;
+                return;
+            case stage_t::fb:
+                fb = f;
+                start ();
+                return;
+            case stage_t::fc:
+                fc = f;
+                s = (fa != fc && fb != fc) ?
+                    b - fb * (b - a) / (fb - fa)
+                :
+                      a * fb * fc / ((fa - fb) * (fa - fc))
+                    + b * fa * fc / ((fb - fa) * (fb - fc))
+                    + c * fa * fb / ((fc - fa) * (fc - fb))
+                ;
+                stage = stage_t::fs;
+                return;
+            case stage_t::fs:
+                break;
+        }
+            auto
+        fs = f;
+        if (c > s)
+        {
+                using std::swap;
+            swap (s , c);
+            swap (fs, fc);
+        }
+        if (fs * fc < 0)
+        {
+            a  = s;
+            b  = c;
+            fa = fs;
+            fb = fc;
+        }
+        else
+        {
+            if (fs * fb < 0)
+            {
+                a  = c;
+                fa = fc;
+            }
+            else
+            {
+                b  = s;
+                fb = fs;
+            }
+        }
+        if (fa == 0 || fb == 0 || options.converged (a, b, fa, fb))
+        {
+            status_ = solver_status_t::converged;
+            return;
+        }
+        if (++iteration >= options.max_iter)
+        {
+            status_ = solver_status_t::no_convergence;
+            return;
+        }
+        stage = stage_t::fc;
+        c = (a + b) / 2;
+    }
+
+        solver_status_t
+    status () const
+    {
+        return status_;
+    }
+
+        Value
+    result () const
+    {
+        if (status_ == solver_status_t::converged)
+        {
+            return fa == 0 ? a : fb == 0 ? b : (a + b) / 2;
+        }
+        return (a + b) / 2;
+    }
+
+        info::data::zhang_iterations_t
+    info () const
+    {
+            auto
+        i = info::data::zhang_iterations_t {};
+        i.converged = status_ == solver_status_t::converged;
+        i.no_single_root_between_bracket = status_ == solver_status_t::no_single_root_between_brackets;
+        i.iteration_count = iteration;
+        return i;
+    }
+};
+} // namespace calculisto::root_finding
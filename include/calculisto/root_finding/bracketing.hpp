@@ -0,0 +1,944 @@
+#pragma once
+#include "root_finding.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+// Alternatives to zhang, with the same signature, the same options (plus a few
+// of their own), the same exceptions and the same info: they can be swapped in.
+
+//------------------------------------------------------------------------------
+// ITP (Interpolate, Truncate, Project), Oliveira & Takahashi, "An Enhancement of
+// the Bisection Method Average Performance Preserving Minmax Optimality", ACM
+// TOMS 47 (2020). One evaluation per iteration, and never more iterations than
+// the bisection plus n0.
+    struct
+ItpTag
+{};
+
+    template <
+          class Value
+        , class FunctionResult
+        , class Observer = no_observer_t
+    >
+    struct
+itp_options_t
+{
+        int
+    max_iter = 100;
+        std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+    converged = zhang_default_converged <Value, FunctionResult>;
+    // Half the width of the final bracket. 0 for epsilon, relative to the
+    // bracket beyond 1.
+        Value
+    tolerance = 0;
+    // Truncation, kappa1 (b - a)^kappa2. 0 for kappa1 = 0.2 / (b - a).
+        Value
+    kappa1 = 0;
+        Value
+    kappa2 = 2;
+    // Slack on the number of iterations of the bisection.
+        int
+    n0 = 1;
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+itp_no_convergence_e = zhang_no_convergence_e;
+
+    using
+itp_no_single_root_between_brackets_e = zhang_no_single_root_between_brackets_e;
+
+    namespace
+info::data
+{
+        template <class... Ts>
+        struct
+    select <ItpTag, tag::iterations, Ts...>
+    {
+            using
+        type = zhang_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <ItpTag, tag::convergence, Function, Value>
+    {
+            using
+        type = convergence_zhang_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    auto
+itp (
+      Function&&  function
+    , Value       a // bracket 1
+    , Value       b // bracket 2
+    , itp_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          ItpTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        FunctionResult
+      fa
+    , fb
+    ;
+    try
+    {
+        fa = std::forward <Function> (function) (a);
+        fb = std::forward <Function> (function) (b);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    if (fa * fb > 0)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.no_single_root_between_bracket = true;
+            return std::pair { (a + b) / 2,  info_data };
+        }
+        else
+        {
+            throw itp_no_single_root_between_brackets_e {};
+        }
+    }
+    options.observer (iteration_event_t <Value, FunctionResult> { "itp", 0, step_t::initial, a, fa });
+    options.observer (iteration_event_t <Value, FunctionResult> { "itp", 0, step_t::initial, b, fb });
+        using std::fabs;
+        using std::pow;
+        using std::log2;
+        using std::ceil;
+        using std::ldexp;
+        const auto
+    epsilon = options.tolerance > 0
+        ? options.tolerance
+        : std::numeric_limits <Value>::epsilon ()
+            * std::max ({ Value (1), Value (fabs (a)), Value (fabs (b)) })
+    ;
+        const auto
+    kappa1 = options.kappa1 > 0 ? options.kappa1 : Value (0.2) / (b - a);
+        const auto
+    n_max = static_cast <int> (std::max (Value (0), ceil (log2 ((b - a) / (2 * epsilon))))) + options.n0;
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+        if (fa == 0 || fb == 0 || b - a <= 2 * epsilon)
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+                const auto
+            r = fa == 0 ? a : fb == 0 ? b : (a + b) / 2;
+            if constexpr (need_info)
+            {
+                return std::pair { r, info_data };
+            }
+            else
+            {
+                return r;
+            }
+        }
+        // Interpolate,
+            const auto
+        x_half = (a + b) / 2;
+            const auto
+        x_f = (b * fa - a * fb) / (fa - fb);
+        // truncate,
+            const auto
+        sigma = x_half - x_f >= 0 ? Value (1) : Value (-1);
+            const auto
+        delta = kappa1 * pow (b - a, options.kappa2);
+            const auto
+        x_t = delta <= fabs (x_half - x_f) ? x_f + sigma * delta : x_half;
+        // and project.
+            const auto
+        r = ldexp (epsilon, n_max - i) - (b - a) / 2;
+            const auto
+        x = fabs (x_t - x_half) <= r ? x_t : x_half - sigma * r;
+            auto
+        fx = FunctionResult {};
+        try
+        {
+            fx = std::forward <Function> (function) (x);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.function_threw = true;
+                return std::pair { (a + b) / 2, info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "itp"
+            , i
+            , x == x_f ? step_t::secant : x == x_half ? step_t::bisection : step_t::projection
+            , x
+            , fx
+        });
+        if (fx == 0)
+        {
+            a  = b  = x;
+            fa = fb = fx;
+        }
+        else if ((fx < 0) == (fa < 0))
+        {
+            a  = x;
+            fa = fx;
+        }
+        else
+        {
+            b  = x;
+            fb = fx;
+        }
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({ a, b, fa, fb });
+        }
+        if (options.converged (a, b, fa, fb))
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            if constexpr (need_info)
+            {
+                return std::pair { (a + b) / 2,  info_data };
+            }
+            else
+            {
+                return (a + b) / 2;
+            }
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.converged = false;
+        return std::pair { (a + b) / 2, info_data };
+    }
+    else
+    {
+        throw itp_no_convergence_e {};
+    }
+}
+
+//------------------------------------------------------------------------------
+// Chandrupatla, "A new hybrid quadratic/bisection algorithm for finding the
+// zero of a nonlinear function without using derivatives", Adv. Eng. Softw. 28
+// (1997). Inverse quadratic interpolation when it is safe, bisection otherwise,
+// one evaluation per iteration.
+    struct
+ChandrupatlaTag
+{};
+
+    template <class Value, class FunctionResult, class... Ts>
+    using
+chandrupatla_options_t = zhang_options_t <Value, FunctionResult, Ts...>;
+
+    using
+chandrupatla_no_convergence_e = zhang_no_convergence_e;
+
+    using
+chandrupatla_no_single_root_between_brackets_e = zhang_no_single_root_between_brackets_e;
+
+    namespace
+info::data
+{
+        template <class... Ts>
+        struct
+    select <ChandrupatlaTag, tag::iterations, Ts...>
+    {
+            using
+        type = zhang_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <ChandrupatlaTag, tag::convergence, Function, Value>
+    {
+            using
+        type = convergence_zhang_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
+    >
+    auto
+chandrupatla (
+      Function&&  function
+    , Value       a // bracket 1
+    , Value       b // bracket 2
+    , chandrupatla_options_t <Value, FunctionResult, Converged, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          ChandrupatlaTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        FunctionResult
+      fa
+    , fb
+    ;
+    try
+    {
+        fa = std::forward <Function> (function) (a);
+        fb = std::forward <Function> (function) (b);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    if (fa * fb > 0)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.no_single_root_between_bracket = true;
+            return std::pair { (a + b) / 2,  info_data };
+        }
+        else
+        {
+            throw chandrupatla_no_single_root_between_brackets_e {};
+        }
+    }
+    options.observer (iteration_event_t <Value, FunctionResult> { "chandrupatla", 0, step_t::initial, a, fa });
+    options.observer (iteration_event_t <Value, FunctionResult> { "chandrupatla", 0, step_t::initial, b, fb });
+    // a is the last point, b the other end of the bracket, c the previous
+    // point.
+        auto
+    c = a;
+        auto
+    fc = fa;
+        auto
+    t = Value (0.5);
+        auto
+    return_ = [&](bool converged, int i)
+    {
+            const auto
+        r = fa == 0 ? a : fb == 0 ? b : (a + b) / 2;
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = i;
+        }
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { r, info_data };
+        }
+        else
+        {
+            return r;
+        }
+    };
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+            const auto
+        x = a + t * (b - a);
+            auto
+        fx = FunctionResult {};
+        try
+        {
+            fx = std::forward <Function> (function) (x);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.function_threw = true;
+                return return_ (false, i);
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "chandrupatla"
+            , i
+            , t == Value (0.5) ? step_t::bisection : step_t::inverse_quadratic
+            , x
+            , fx
+        });
+        if ((fx < 0) == (fa < 0))
+        {
+            c  = a;
+            fc = fa;
+        }
+        else
+        {
+            c  = b;
+            fc = fb;
+            b  = a;
+            fb = fa;
+        }
+        a  = x;
+        fa = fx;
+            const auto
+        lo = a < b ? std::pair { a, fa } : std::pair { b, fb };
+            const auto
+        hi = a < b ? std::pair { b, fb } : std::pair { a, fa };
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({ lo.first, hi.first, lo.second, hi.second });
+        }
+        if (options.converged (lo.first, hi.first, lo.second, hi.second))
+        {
+            return return_ (true, i);
+        }
+        // Next point: inverse quadratic interpolation if the bracket and the
+        // function are close enough to quadratic, bisection otherwise, and
+        // never closer to the ends than the resolution.
+            using std::fabs;
+            const auto
+        tolerance = std::numeric_limits <Value>::epsilon ()
+            * std::max ({ Value (1), Value (fabs (a)), Value (fabs (b)) })
+        ;
+            const auto
+        t_lim = tolerance / fabs (b - a);
+        if (t_lim >= Value (0.5))
+        {
+            return return_ (true, i);
+        }
+            const auto
+        xi = (a - b) / (c - b);
+            const auto
+        phi = (fa - fb) / (fc - fb);
+        if (phi * phi < xi && (1 - phi) * (1 - phi) < 1 - xi)
+        {
+            t = fa / (fb - fa) * fc / (fb - fc)
+                + (c - a) / (b - a) * fa / (fc - fa) * fb / (fc - fb)
+            ;
+        }
+        else
+        {
+            t = 0.5;
+        }
+        t = std::clamp (t, t_lim, 1 - t_lim);
+    }
+    if constexpr (need_info)
+    {
+        return return_ (false, options.max_iter);
+    }
+    else
+    {
+        throw chandrupatla_no_convergence_e {};
+    }
+}
+
+//------------------------------------------------------------------------------
+// Alefeld, Potra & Shi, "Algorithm 748: Enclosing Zeros of Continuous
+// Functions", ACM TOMS 21 (1995), algorithm 4.2: two inverse cubic (or
+// quadratic) interpolation steps and a double-length secant step per
+// iteration, followed by a bisection when the bracket has not shrunk enough.
+// Each evaluation counts as an iteration.
+    struct
+Toms748Tag
+{};
+
+    template <class Value, class FunctionResult, class... Ts>
+    using
+toms748_options_t = zhang_options_t <Value, FunctionResult, Ts...>;
+
+    using
+toms748_no_convergence_e = zhang_no_convergence_e;
+
+    using
+toms748_no_single_root_between_brackets_e = zhang_no_single_root_between_brackets_e;
+
+    namespace
+info::data
+{
+        template <class... Ts>
+        struct
+    select <Toms748Tag, tag::iterations, Ts...>
+    {
+            using
+        type = zhang_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <Toms748Tag, tag::convergence, Function, Value>
+    {
+            using
+        type = convergence_zhang_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    namespace
+toms748_detail
+{
+    // num / denom, or r if that would overflow.
+        template <class T>
+        T
+    safe_div (T num, T denom, T r)
+    {
+            using std::fabs;
+        if (fabs (denom) < 1 && fabs (denom * std::numeric_limits <T>::max ()) <= fabs (num))
+        {
+            return r;
+        }
+        return num / denom;
+    }
+
+        template <class Value, class FunctionResult>
+        Value
+    secant (Value a, Value b, FunctionResult fa, FunctionResult fb)
+    {
+            using std::fabs;
+            const auto
+        tol = 5 * std::numeric_limits <Value>::epsilon ();
+            const auto
+        c = a - (fa / (fb - fa)) * (b - a);
+        if (c <= a + fabs (a) * tol || c >= b - fabs (b) * tol)
+        {
+            return (a + b) / 2;
+        }
+        return c;
+    }
+
+    // count Newton steps on the quadratic through (a, fa), (b, fb), (d, fd).
+        template <class Value, class FunctionResult>
+        Value
+    quadratic (Value a, Value b, Value d, FunctionResult fa, FunctionResult fb, FunctionResult fd, int count)
+    {
+            const auto
+        B = safe_div (FunctionResult (fb - fa), FunctionResult (b - a), std::numeric_limits <FunctionResult>::max ());
+            auto
+        A = safe_div (FunctionResult (fd - fb), FunctionResult (d - b), std::numeric_limits <FunctionResult>::max ());
+        A = safe_div (FunctionResult (A - B), FunctionResult (d - a), FunctionResult (0));
+        if (A == 0)
+        {
+            return secant (a, b, fa, fb);
+        }
+            auto
+        c = (A < 0) == (fa < 0) ? a : b;
+        for (auto i = 0; i < count; ++i)
+        {
+            c -= safe_div (
+                  FunctionResult (fa + (B + A * (c - b)) * (c - a))
+                , FunctionResult (B + A * (2 * c - a - b))
+                , FunctionResult (1 + c - a)
+            );
+        }
+        if (c <= a || c >= b)
+        {
+            return secant (a, b, fa, fb);
+        }
+        return c;
+    }
+
+    // Inverse cubic interpolation through the four points.
+        template <class Value, class FunctionResult>
+        Value
+    cubic (
+          Value a, Value b, Value d, Value e
+        , FunctionResult fa, FunctionResult fb, FunctionResult fd, FunctionResult fe
+    ){
+            const auto
+        q11 = (d - e) * fd / (fe - fd);
+            const auto
+        q21 = (b - d) * fb / (fd - fb);
+            const auto
+        q31 = (a - b) * fa / (fb - fa);
+            const auto
+        d21 = (b - d) * fd / (fd - fb);
+            const auto
+        d31 = (a - b) * fb / (fb - fa);
+            const auto
+        q22 = (d21 - q11) * fb / (fe - fb);
+            const auto
+        q32 = (d31 - q21) * fa / (fd - fa);
+            const auto
+        d32 = (d31 - q21) * fd / (fd - fa);
+            const auto
+        q33 = (d32 - q22) * fa / (fe - fa);
+            const auto
+        c = q31 + q32 + q33 + a;
+        if (!(c > a && c < b))
+        {
+            return quadratic (a, b, d, fa, fb, fd, 3);
+        }
+        return c;
+    }
+} // namespace toms748_detail
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
+    >
+    auto
+toms748 (
+      Function&&  function
+    , Value       a // bracket 1
+    , Value       b // bracket 2
+    , toms748_options_t <Value, FunctionResult, Converged, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          Toms748Tag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        FunctionResult
+      fa
+    , fb
+    ;
+    try
+    {
+        fa = std::forward <Function> (function) (a);
+        fb = std::forward <Function> (function) (b);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    if (fa * fb > 0)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.no_single_root_between_bracket = true;
+            return std::pair { (a + b) / 2,  info_data };
+        }
+        else
+        {
+            throw toms748_no_single_root_between_brackets_e {};
+        }
+    }
+    options.observer (iteration_event_t <Value, FunctionResult> { "toms748", 0, step_t::initial, a, fa });
+    options.observer (iteration_event_t <Value, FunctionResult> { "toms748", 0, step_t::initial, b, fb });
+        using std::fabs;
+        using namespace toms748_detail;
+    // [a, b] is the bracket, d the point just dropped from it, e the one
+    // dropped before.
+        auto
+      d = a
+    , e = a
+    ;
+        auto
+      fd = fa
+    , fe = fa
+    ;
+        auto
+    i = 0;
+        enum
+    {
+          running
+        , converged
+        , exhausted
+        , threw
+    }   state = fa == 0 || fb == 0 ? converged : running;
+    // Evaluates the function at c, kept off the ends of the bracket, and
+    // shrinks the bracket. Returns true when done.
+        auto
+    step = [&](Value c, step_t kind)
+    {
+            const auto
+        tol = 2 * std::numeric_limits <Value>::epsilon ();
+        if (b - a < 2 * tol * fabs (a))
+        {
+            c = a + (b - a) / 2;
+        }
+        else if (c <= a + fabs (a) * tol)
+        {
+            c = a + fabs (a) * tol;
+        }
+        else if (c >= b - fabs (b) * tol)
+        {
+            c = b - fabs (b) * tol;
+        }
+            auto
+        fc = FunctionResult {};
+        try
+        {
+            fc = std::forward <Function> (function) (c);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.function_threw = true;
+                state = threw;
+                return true;
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> { "toms748", i, kind, c, fc });
+        ++i;
+        if (fc == 0)
+        {
+            a  = b  = c;
+            fa = fb = fc;
+        }
+        else if ((fc < 0) == (fa < 0))
+        {
+            d  = a;
+            fd = fa;
+            a  = c;
+            fa = fc;
+        }
+        else
+        {
+            d  = b;
+            fd = fb;
+            b  = c;
+            fb = fc;
+        }
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({ a, b, fa, fb });
+        }
+        if (fa == 0 || fb == 0 || options.converged (a, b, fa, fb))
+        {
+            state = converged;
+        }
+        else if (i >= options.max_iter)
+        {
+            state = exhausted;
+        }
+        return state != running;
+    };
+    // Interpolation is unreliable if any two of the values are too close.
+        auto
+    close_values = [&]
+    {
+            const auto
+        min_diff = std::numeric_limits <FunctionResult>::min () * 32;
+        return fabs (fa - fb) < min_diff
+            || fabs (fa - fd) < min_diff
+            || fabs (fa - fe) < min_diff
+            || fabs (fb - fd) < min_diff
+            || fabs (fb - fe) < min_diff
+            || fabs (fd - fe) < min_diff
+        ;
+    };
+    // Start with a secant step, then a quadratic one, ...
+    if (state == running && !step (secant (a, b, fa, fb), step_t::secant))
+    {
+        e  = d;
+        fe = fd;
+        step (quadratic (a, b, d, fa, fb, fd, 2), step_t::quadratic);
+    }
+    // ... then iterate.
+    while (state == running)
+    {
+            const auto
+          a0 = a
+        , b0 = b
+        ;
+            auto
+        kind = close_values () ? step_t::quadratic : step_t::cubic;
+            auto
+        c = kind == step_t::quadratic
+            ? quadratic (a, b, d, fa, fb, fd, 2)
+            : cubic (a, b, d, e, fa, fb, fd, fe)
+        ;
+        e  = d;
+        fe = fd;
+        if (step (c, kind))
+        {
+            break;
+        }
+        kind = close_values () ? step_t::quadratic : step_t::cubic;
+        c = kind == step_t::quadratic
+            ? quadratic (a, b, d, fa, fb, fd, 3)
+            : cubic (a, b, d, e, fa, fb, fd, fe)
+        ;
+        if (step (c, kind))
+        {
+            break;
+        }
+            const auto
+        [ u, fu ] = fabs (fa) < fabs (fb) ? std::pair { a, fa } : std::pair { b, fb };
+        c = u - 2 * (fu / (fb - fa)) * (b - a);
+        kind = step_t::secant;
+        if (fabs (c - u) > (b - a) / 2)
+        {
+            c = a + (b - a) / 2;
+            kind = step_t::bisection;
+        }
+        e  = d;
+        fe = fd;
+        if (step (c, kind))
+        {
+            break;
+        }
+        if (b - a < Value (0.5) * (b0 - a0))
+        {
+            continue;
+        }
+        e  = d;
+        fe = fd;
+        step (a + (b - a) / 2, step_t::bisection);
+    }
+    if constexpr (need_info_iterations)
+    {
+        info_data.iteration_count = i;
+    }
+        const auto
+    r = fa == 0 ? a : fb == 0 ? b : (a + b) / 2;
+    if (state == converged)
+    {
+        if constexpr (need_info)
+        {
+            return std::pair { r, info_data };
+        }
+        else
+        {
+            return r;
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.converged = false;
+        return std::pair { r, info_data };
+    }
+    else
+    {
+        throw toms748_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
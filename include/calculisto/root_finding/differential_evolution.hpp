@@ -0,0 +1,420 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <cstdint>
+#include <random>
+#include <span>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Differential evolution (DE/rand/1/bin) in a box, after
+// Storn & Price, "Differential evolution - a simple and efficient heuristic
+// for global optimization over continuous spaces", J. Glob. Optim. 11 (1997).
+// The trial population of each generation is evaluated at once: by a single
+// call, if the function takes a std::span of points and returns their values
+// in an indexable container, or else point by point, on several threads (the
+// function must then be safe to call from several threads). A generic lambda
+// is evaluated point by point.
+    struct
+DifferentialEvolutionTag
+{};
+
+    namespace
+differential_evolution_detail
+{
+        template <class Function, class Point>
+        concept
+    batch = !std::invocable <Function, Point>
+        && std::invocable <Function, std::span <Point const>>
+    ;
+
+        template <class Function, class Point>
+        struct
+    result
+    {
+            using
+        type = std::invoke_result_t <Function, Point>;
+    };
+
+        template <class Function, class Point>
+        requires batch <Function, Point>
+        struct
+    result <Function, Point>
+    {
+            using
+        type = std::remove_cvref_t <decltype (
+            std::declval <std::invoke_result_t <Function, std::span <Point const>>&> ()[0]
+        )>;
+    };
+} // namespace differential_evolution_detail
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+differential_evolution_options_t
+{
+        int
+    max_iter = 1000;
+    // Converged when all the function values of the population are within
+    // tolerance * (1 + |best|) of the best one.
+        FunctionResult
+    tolerance = std::sqrt (std::numeric_limits <FunctionResult>::epsilon ());
+    // 0: 10 times the dimension, and at least 4.
+        int
+    population = 0;
+    // Differential weight and crossover probability.
+        Value
+      weight = Value (0.8)
+    , crossover = Value (0.9)
+    ;
+        std::uint64_t
+    seed = 0;
+    // For the point by point evaluation.
+        unsigned
+    threads = default_thread_count ();
+    // Run powell from the best member, and keep its result if better and in
+    // the box.
+        bool
+    polish = false;
+        powell_options_t <Value, FunctionResult>
+    powell_options = {};
+    // At each evaluation of a member, the iteration being the generation, once
+    // the whole population is (not for the polish).
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+differential_evolution_no_convergence_e = defaults::no_convergence_e;
+
+    namespace
+info::data
+{
+        struct
+    differential_evolution_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+        // powell improved the best member.
+            bool
+        polished = false;
+    };
+
+        template <
+              class Point
+            , class FunctionResult
+        >
+        struct
+    differential_evolution_convergence_t
+        : differential_evolution_iterations_t
+    {
+        // generation, best function value, worst one, best point.
+            std::vector <std::tuple <int, FunctionResult, FunctionResult, Point>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <DifferentialEvolutionTag, tag::iterations, Ts...>
+    {
+            using
+        type = differential_evolution_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Point
+        >
+        struct
+    select <DifferentialEvolutionTag, tag::convergence, Function, Point>
+    {
+            using
+        type = differential_evolution_convergence_t <
+              Point
+            , typename differential_evolution_detail::result <Function, Point>::type
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , point Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Point>
+        , class FunctionResult = typename differential_evolution_detail::result <Function, Point>::type
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Point>
+        || differential_evolution_detail::batch <Function, Point>
+    auto
+differential_evolution (
+      Function&&   function
+    , Point const& lower
+    , Point const& upper
+    , differential_evolution_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = InfoTag != info::tag::none;
+        constexpr static auto
+    batch = differential_evolution_detail::batch <Function, Point>;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          DifferentialEvolutionTag
+        , InfoTag
+        , Function
+        , Point
+    > {};
+
+        const auto
+    n = lower.size ();
+        const auto
+    np = static_cast <std::size_t> (std::max (options.population > 0 ? options.population : 10 * static_cast <int> (n), 4));
+        auto
+    rng = std::mt19937_64 { options.seed };
+        auto
+    uniform = std::uniform_real_distribution <Value> { 0, 1 };
+        auto
+    member = std::uniform_int_distribution <std::size_t> { 0, np - 1 };
+        auto
+    component = std::uniform_int_distribution <std::size_t> { 0, n - 1 };
+    // All the storage is allocated once, here.
+        auto
+    x = std::vector <Point> (np, lower);
+        auto
+    fx = std::vector <FunctionResult> (np);
+        auto
+    trial = std::vector <Point> (np, lower);
+        auto
+    ft = std::vector <FunctionResult> (np);
+        auto
+    evaluate = [&](std::vector <Point> const& points, std::vector <FunctionResult>& values, int generation)
+    {
+        if constexpr (batch)
+        {
+                auto const&
+            r = function (std::span <Point const> { points });
+            for (auto j = 0u; j < np; ++j)
+            {
+                values[j] = r[j];
+            }
+        }
+        else
+        {
+            parallel_for (np, options.threads, [&](std::size_t j)
+            {
+                values[j] = function (points[j]);
+            });
+        }
+        if constexpr (need_info)
+        {
+            info_data.evaluation_count += static_cast <int> (np);
+        }
+        for (auto j = 0u; j < np; ++j)
+        {
+            options.observer (iteration_event_t <Point, FunctionResult> {
+                  "differential_evolution"
+                , generation
+                , generation == 0 ? step_t::initial : step_t::evolution
+                , points[j]
+                , values[j]
+            });
+        }
+    };
+        auto
+    best_point = [&]
+    {
+            std::size_t
+        b = 0;
+        for (auto j = 1u; j < np; ++j)
+        {
+            if (fx[j] < fx[b]) b = j;
+        }
+        return b;
+    };
+        auto
+    worst_point = [&]
+    {
+            std::size_t
+        w = 0;
+        for (auto j = 1u; j < np; ++j)
+        {
+            if (fx[j] > fx[w]) w = j;
+        }
+        return w;
+    };
+        auto
+    in_box = [&](auto const& p)
+    {
+        for (auto k = 0u; k < n; ++k)
+        {
+            if (p[k] < lower[k] || p[k] > upper[k]) return false;
+        }
+        return true;
+    };
+    // Polishes the best member, and returns it.
+        auto
+    finish = [&]
+    {
+            const auto
+        b = best_point ();
+        if (!options.polish)
+        {
+            return x[b];
+        }
+            auto
+        v = std::valarray <Value> (n);
+        for (auto k = 0u; k < n; ++k)
+        {
+            v[k] = x[b][k];
+        }
+            auto
+        p = x[b];
+            auto
+        polish_function = [&](std::valarray <Value> const& y)
+        {
+            for (auto k = 0u; k < n; ++k)
+            {
+                p[k] = y[k];
+            }
+            if constexpr (batch)
+            {
+                return FunctionResult (function (std::span <Point const> { &p, 1 })[0]);
+            }
+            else
+            {
+                return FunctionResult (function (p));
+            }
+        };
+            auto
+        [ y, powell_info ] = powell (polish_function, std::move (v), options.powell_options, info::iterations);
+        if constexpr (need_info)
+        {
+            info_data.evaluation_count += powell_info.evaluation_count;
+        }
+        if (powell_info.function_threw || !in_box (y))
+        {
+            return x[b];
+        }
+            const auto
+        fy = polish_function (y);
+        if (!(fy < fx[b]))
+        {
+            return x[b];
+        }
+        if constexpr (need_info)
+        {
+            info_data.polished = true;
+        }
+        return p;
+    };
+    try
+    {
+        for (auto& p: x)
+        {
+            for (auto k = 0u; k < n; ++k)
+            {
+                p[k] = lower[k] + uniform (rng) * (upper[k] - lower[k]);
+            }
+        }
+        evaluate (x, fx, 0);
+        for (int i = 0;; ++i)
+        {
+                const auto
+            b = best_point ();
+                const auto
+            w = worst_point ();
+            if constexpr (need_info_convergence)
+            {
+                info_data.convergence.push_back ({ i, fx[b], fx[w], x[b] });
+            }
+                using std::fabs;
+            if (fx[w] - fx[b] <= options.tolerance * (1 + fabs (fx[b])))
+            {
+                if constexpr (need_info)
+                {
+                    info_data.iteration_count = i;
+                    return std::pair { finish (), info_data };
+                }
+                else
+                {
+                    return finish ();
+                }
+            }
+            if (i == options.max_iter)
+            {
+                break;
+            }
+            for (auto j = 0u; j < np; ++j)
+            {
+                    std::size_t
+                r1, r2, r3;
+                do r1 = member (rng); while (r1 == j);
+                do r2 = member (rng); while (r2 == j || r2 == r1);
+                do r3 = member (rng); while (r3 == j || r3 == r1 || r3 == r2);
+                    const auto
+                forced = component (rng);
+                for (auto k = 0u; k < n; ++k)
+                {
+                    if (k != forced && !(uniform (rng) < options.crossover))
+                    {
+                        trial[j][k] = x[j][k];
+                        continue;
+                    }
+                    trial[j][k] = x[r1][k] + options.weight * (x[r2][k] - x[r3][k]);
+                    // Out of the box: half way between the parent and the
+                    // bound.
+                    if (trial[j][k] < lower[k])
+                    {
+                        trial[j][k] = (x[j][k] + lower[k]) / 2;
+                    }
+                    else if (trial[j][k] > upper[k])
+                    {
+                        trial[j][k] = (x[j][k] + upper[k]) / 2;
+                    }
+                }
+            }
+            evaluate (trial, ft, i + 1);
+            for (auto j = 0u; j < np; ++j)
+            {
+                if (ft[j] <= fx[j])
+                {
+                    std::swap (x[j], trial[j]);
+                    fx[j] = ft[j];
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { x[best_point ()], info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.iteration_count = options.max_iter;
+        info_data.converged = false;
+        return std::pair { x[best_point ()], info_data };
+    }
+    else
+    {
+        throw differential_evolution_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
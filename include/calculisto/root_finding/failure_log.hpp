@@ -0,0 +1,381 @@
+#pragma once
+#include "root_finding.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// A log of the failed solves, to reproduce them offline: the recorder appends
+// the inputs of the problem (whatever the caller needs to set it up again,
+// e.g. its parameters and the guess or the bracket) and the convergence
+// history (from info::convergence: its rows, whose points, pairs and
+// enumerators are flattened to numbers, or, for powell, its flattened rows) of
+// each solve that did not converge, to a file, up to a size. The reader maps
+// the file, and replay_failures hands the records to any solver.
+//
+// The file is in the native byte order and floating point format, all 8 bytes
+// aligned: a magic number, then the records, each a header (the name of the
+// solver, on 16 chars, and the number of inputs, of rows and of columns of the
+// history, as 64 bits unsigned integers) followed by the inputs and the
+// history, row by row, as doubles.
+
+    struct
+failure_log_options_t
+{
+    // Records that would make the file larger are dropped.
+        std::uintmax_t
+    max_bytes = 64 << 20;
+};
+
+// The file can't be written, or read, or is not a failure log.
+    struct
+failure_log_bad_file_e
+{};
+
+    namespace
+failure_log_detail
+{
+        constexpr char
+    magic[8] = { 'C', 'R', 'F', 'F', 'A', 'I', 'L', '1' };
+
+        struct
+    header_t
+    {
+            char
+        solver[16];
+            std::uint64_t
+          input_count
+        , rows
+        , columns
+        ;
+    };
+
+    // Appends a column of the history as doubles: a number, or an enumerator,
+    // as one, a pair, a tuple or a point as its elements, in order. Any other
+    // column does not compile.
+        template <class T>
+        void
+    flatten (T const& x, std::vector <double>& history)
+    {
+        if constexpr (std::is_convertible_v <T, double>)
+        {
+            history.push_back (static_cast <double> (x));
+        }
+        else if constexpr (std::is_enum_v <T>)
+        {
+            history.push_back (static_cast <double> (static_cast <std::underlying_type_t <T>> (x)));
+        }
+        else if constexpr (requires { std::tuple_size <T>::value; })
+        {
+            std::apply ([&](auto const&... element){ (flatten (element, history), ...); }, x);
+        }
+        else if constexpr (requires { std::begin (x); std::end (x); })
+        {
+            for (auto const& element: x)
+            {
+                flatten (element, history);
+            }
+        }
+        else
+        {
+            static_assert (sizeof (T) == 0, "A column of the history that is not made of numbers.");
+        }
+    }
+} // namespace failure_log_detail
+
+// Appends to the file, creating it if needed. Can be shared between threads.
+    class
+failure_recorder_t
+{
+        std::ofstream
+    out;
+        failure_log_options_t
+    options;
+        std::uintmax_t
+    size = 0;
+        std::uint64_t
+    dropped_ = 0;
+        mutable std::mutex
+    mutex;
+
+    public:
+    explicit
+    failure_recorder_t (std::string const& path, failure_log_options_t const& options = {})
+        : out { path, std::ios::binary | std::ios::app }
+        , options { options }
+    {
+        if (!out)
+        {
+            throw failure_log_bad_file_e {};
+        }
+            std::error_code
+        error;
+        size = std::filesystem::file_size (path, error);
+        if (error)
+        {
+            throw failure_log_bad_file_e {};
+        }
+        if (size == 0)
+        {
+            out.write (failure_log_detail::magic, sizeof failure_log_detail::magic);
+            out.flush ();
+            size = sizeof failure_log_detail::magic;
+        }
+    }
+
+    // Records the solve if it did not converge. Returns true if it did.
+        template <class Info>
+        bool
+    record (char const* solver, std::span <double const> inputs, Info const& info)
+    {
+        if (info.converged)
+        {
+            return false;
+        }
+            auto
+        header = failure_log_detail::header_t { {}, inputs.size (), 0, 0 };
+        std::strncpy (header.solver, solver, sizeof header.solver - 1);
+            auto
+        history = std::vector <double> {};
+        if constexpr (requires { info.convergence; })
+        {
+            header.rows = info.convergence.size ();
+            for (auto const& row: info.convergence)
+            {
+                failure_log_detail::flatten (row, history);
+                if (header.columns == 0)
+                {
+                    header.columns = history.size ();
+                }
+            }
+        }
+        else if constexpr (requires { info.columns (); info.visit_row (0, [](auto const&){}); })
+        {
+            // Columnar, e.g. powell's.
+            header.rows = info.size ();
+            header.columns = info.columns ();
+            for (auto i = 0u; i < header.rows; ++i)
+            {
+                info.visit_row (i, [&](auto const& column)
+                {
+                    failure_log_detail::flatten (column, history);
+                });
+            }
+        }
+            const auto
+        bytes = sizeof header + (inputs.size () + history.size ()) * sizeof (double);
+            std::scoped_lock
+        lock { mutex };
+        if (size + bytes > options.max_bytes)
+        {
+            ++dropped_;
+            return false;
+        }
+        out.write (reinterpret_cast <char const*> (&header), sizeof header);
+        out.write (reinterpret_cast <char const*> (inputs.data ()), static_cast <std::streamsize> (inputs.size () * sizeof (double)));
+        out.write (reinterpret_cast <char const*> (history.data ()), static_cast <std::streamsize> (history.size () * sizeof (double)));
+        out.flush ();
+        if (!out)
+        {
+            throw failure_log_bad_file_e {};
+        }
+        size += bytes;
+        return true;
+    }
+
+    // How many records were dropped, for the size.
+        std::uint64_t
+    dropped () const
+    {
+            std::scoped_lock
+        lock { mutex };
+        return dropped_;
+    }
+};
+
+// A record, in the mapped file.
+    struct
+failure_record_t
+{
+        std::string_view
+    solver;
+        std::span <double const>
+    inputs;
+        std::size_t
+      rows
+    , columns
+    ;
+        std::span <double const>
+    history;
+
+        std::span <double const>
+    row (std::size_t i) const
+    {
+        return history.subspan (i * columns, columns);
+    }
+};
+
+// Maps a file written by failure_recorder_t, read only.
+    class
+mapped_failure_log_t
+{
+        void*
+    address = nullptr;
+        std::size_t
+    size = 0;
+        std::vector <failure_record_t>
+    records_;
+
+    public:
+    explicit
+    mapped_failure_log_t (std::string const& path)
+    {
+            const auto
+        fd = ::open (path.c_str (), O_RDONLY);
+        if (fd < 0)
+        {
+            throw failure_log_bad_file_e {};
+        }
+            struct stat
+        st;
+        if (::fstat (fd, &st) == 0 && st.st_size > 0)
+        {
+            size = static_cast <std::size_t> (st.st_size);
+            address = ::mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close (fd);
+        if (address == nullptr || address == MAP_FAILED)
+        {
+            address = nullptr;
+            throw failure_log_bad_file_e {};
+        }
+            const auto
+        bytes = static_cast <char const*> (address);
+            auto
+        bad = size < sizeof failure_log_detail::magic
+            || std::memcmp (bytes, failure_log_detail::magic, sizeof failure_log_detail::magic) != 0
+        ;
+            auto
+        offset = sizeof failure_log_detail::magic;
+        while (!bad && offset < size)
+        {
+                auto
+            header = failure_log_detail::header_t {};
+            if (size - offset < sizeof header)
+            {
+                bad = true;
+                break;
+            }
+            std::memcpy (&header, bytes + offset, sizeof header);
+            offset += sizeof header;
+            // Without overflow, for corrupt headers.
+                const auto
+            remaining = (size - offset) / sizeof (double);
+            if (
+                   header.solver[sizeof header.solver - 1] != 0
+                || header.input_count > remaining
+                || (header.columns != 0 && header.rows > (remaining - header.input_count) / header.columns)
+            ){
+                bad = true;
+                break;
+            }
+                const auto
+            count = header.input_count + header.rows * header.columns;
+                const auto
+            data = reinterpret_cast <double const*> (bytes + offset);
+            records_.push_back ({
+                  std::string_view { bytes + offset - sizeof header }
+                , { data, header.input_count }
+                , header.rows
+                , header.columns
+                , { data + header.input_count, header.rows * header.columns }
+            });
+            offset += count * sizeof (double);
+        }
+        if (bad)
+        {
+            ::munmap (address, size);
+            throw failure_log_bad_file_e {};
+        }
+    }
+
+    mapped_failure_log_t (mapped_failure_log_t const&) = delete;
+
+        mapped_failure_log_t&
+    operator = (mapped_failure_log_t const&) = delete;
+
+    mapped_failure_log_t (mapped_failure_log_t&& other) noexcept
+        : address { std::exchange (other.address, nullptr) }
+        , size { other.size }
+        , records_ { std::move (other.records_) }
+    {}
+
+    ~mapped_failure_log_t ()
+    {
+        if (address)
+        {
+            ::munmap (address, size);
+        }
+    }
+
+        std::vector <failure_record_t> const&
+    records () const
+    {
+        return records_;
+    }
+};
+
+// What solve returned for a record, and how long it took.
+    template <class Result>
+    struct
+replay_t
+{
+        Result
+    result;
+        std::chrono::nanoseconds
+    duration;
+};
+
+// Calls solve (record) for each record, which sets the problem up again from
+// the inputs and solves it, with any solver.
+    template <class Solve>
+    auto
+replay_failures (mapped_failure_log_t const& log, Solve&& solve)
+{
+        using
+    result_t = std::invoke_result_t <Solve&, failure_record_t const&>;
+        auto
+    replays = std::vector <replay_t <result_t>> {};
+    replays.reserve (log.records ().size ());
+    for (auto const& record: log.records ())
+    {
+            const auto
+        start = std::chrono::steady_clock::now ();
+            auto
+        result = solve (record);
+        replays.push_back ({
+              std::move (result)
+            , std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start)
+        });
+    }
+    return replays;
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,355 @@
+#pragma once
+#include "root_finding.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Fixed point iteration, x = g (x), accelerated.
+//
+// For a scalar, Aitken's delta-squared process (i.e. the Steffensen
+// iteration): x, g (x), g (g (x)) are extrapolated to the limit, two
+// evaluations per iteration, quadratic convergence.
+//
+// For a point, Anderson acceleration (Walker & Ni, "Anderson acceleration for
+// fixed-point iterations", SIAM J. Numer. Anal. 49 (2011)): the next point
+// combines the last history + 1 iterates so as to minimize the linearized
+// residual, one evaluation per iteration. All the storage is allocated once.
+    struct
+FixedPointTag
+{};
+
+    template <class Point>
+    struct
+fixed_point_value
+{
+        using
+    type = point_value_t <Point>;
+};
+
+    template <class Point>
+    requires std::is_arithmetic_v <Point>
+    struct
+fixed_point_value <Point>
+{
+        using
+    type = Point;
+};
+
+    template <class Point>
+    using
+fixed_point_value_t = typename fixed_point_value <Point>::type;
+
+    template <class Value, class Observer = no_observer_t>
+    struct
+fixed_point_options_t
+{
+        int
+    max_iter = 100;
+    // Converged when the largest component of g (x) - x is below tolerance *
+    // max (1, largest component of x).
+        Value
+    tolerance = 8 * std::numeric_limits <Value>::epsilon ();
+    // Anderson only: number of previous iterates used (0 for the plain
+    // iteration), and the mixing (damping) parameter, x + mixing (g (x) - x)
+    // being the plain step.
+        int
+    history = 5;
+        Value
+    mixing = 1;
+    // With g (x) as f.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+fixed_point_no_convergence_e = defaults::no_convergence_e;
+
+    namespace
+info::data
+{
+        struct
+    fixed_point_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+    };
+
+        template <
+              class Point
+            , class Value
+        >
+        struct
+    fixed_point_convergence_t
+        : fixed_point_iterations_t
+    {
+        // iteration, residual max-norm, point.
+            std::vector <std::tuple <int, Value, Point>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <FixedPointTag, tag::iterations, Ts...>
+    {
+            using
+        type = fixed_point_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Point
+        >
+        struct
+    select <FixedPointTag, tag::convergence, Function, Point>
+    {
+            using
+        type = fixed_point_convergence_t <
+              Point
+            , fixed_point_value_t <Point>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = fixed_point_value_t <Point>
+        , class Observer = no_observer_t
+    >
+    requires
+           std::invocable <Function, Point const&>
+        && (std::is_arithmetic_v <Point> || point <Point>)
+    auto
+fixed_point (
+      Function&&   function
+    , Point const& init
+    , fixed_point_options_t <Value, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          FixedPointTag
+        , InfoTag
+        , Function
+        , Point
+    > {};
+
+        using std::fabs;
+        auto
+    iteration = 0;
+        auto
+    g = [&](Point const& p) -> Point
+    {
+        if constexpr (need_info)
+        {
+            ++info_data.evaluation_count;
+        }
+            const Point
+        gp = function (p);
+        options.observer (iteration_event_t <Point, Point> {
+              "fixed_point"
+            , iteration
+            , iteration == 0 ? step_t::initial : step_t::fixed_point
+            , p
+            , gp
+        });
+        return gp;
+    };
+        auto
+    done = [&](Point const& x, bool converged, int i)
+    {
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = i;
+        }
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { x, info_data };
+        }
+        else
+        {
+            if (!converged)
+            {
+                throw fixed_point_no_convergence_e {};
+            }
+            return x;
+        }
+    };
+        auto
+    x = init;
+    try
+    {
+        if constexpr (std::is_arithmetic_v <Point>)
+        {
+            for (int i = 0; i < options.max_iter; ++i)
+            {
+                iteration = i;
+                    const auto
+                x1 = g (x);
+                    const auto
+                r = x1 - x;
+                if constexpr (need_info_convergence)
+                {
+                    info_data.convergence.push_back ({ i, Value (fabs (r)), x });
+                }
+                if (fabs (r) <= options.tolerance * std::max (Value (1), Value (fabs (x))))
+                {
+                    return done (x1, true, i);
+                }
+                    const auto
+                x2 = g (x1);
+                    const auto
+                d = x2 - 2 * x1 + x;
+                x = d != 0 ? x - r * r / d : x2;
+            }
+        }
+        else
+        {
+                const auto
+            n = init.size ();
+                const auto
+            m = static_cast <std::size_t> (std::max (options.history, 0));
+            // Differences of successive points and residuals, in a circular
+            // buffer, and the normal equations of the least squares problem.
+                auto
+            dx = std::vector <Point> (m, init);
+                auto
+            dr = std::vector <Point> (m, init);
+                auto
+            a = std::vector <Value> (m * m);
+                auto
+            gamma = std::vector <Value> (m);
+                std::size_t
+              newest = 0
+            , count  = 0
+            ;
+                auto
+            r = g (x);
+                auto
+            r_past = r;
+                auto
+            x_past = x;
+                auto
+            max_norm = [&](Point const& p)
+            {
+                    auto
+                v = Value {};
+                for (auto k = 0u; k < n; ++k)
+                {
+                    v = std::max (v, Value (fabs (p[k])));
+                }
+                return v;
+            };
+            for (auto k = 0u; k < n; ++k)
+            {
+                r[k] -= x[k];
+            }
+            for (int i = 0; i < options.max_iter; ++i)
+            {
+                iteration = i + 1;
+                    const auto
+                residual = max_norm (r);
+                if constexpr (need_info_convergence)
+                {
+                    info_data.convergence.push_back ({ i, residual, x });
+                }
+                if (residual <= options.tolerance * std::max (Value (1), max_norm (x)))
+                {
+                    for (auto k = 0u; k < n; ++k)
+                    {
+                        x[k] += r[k];
+                    }
+                    return done (x, true, i);
+                }
+                if (m > 0 && i > 0)
+                {
+                    for (auto k = 0u; k < n; ++k)
+                    {
+                        dx[newest][k] = x[k] - x_past[k];
+                        dr[newest][k] = r[k] - r_past[k];
+                    }
+                    newest = (newest + 1) % m;
+                    count = std::min (count + 1, m);
+                }
+                x_past = x;
+                r_past = r;
+                // The plain step, ...
+                for (auto k = 0u; k < n; ++k)
+                {
+                    x[k] += options.mixing * r[k];
+                }
+                // ... corrected by min || r - dr gamma ||, solved with the
+                // (slightly regularized) normal equations.
+                if (count > 0)
+                {
+                        auto
+                    trace = Value {};
+                    for (auto j = 0u; j < count; ++j)
+                    {
+                        for (auto l = 0u; l <= j; ++l)
+                        {
+                            a[j * count + l] = a[l * count + j] = dot (dr[j], dr[l]);
+                        }
+                        gamma[j] = dot (dr[j], r);
+                        trace += a[j * count + j];
+                    }
+                    for (auto j = 0u; j < count; ++j)
+                    {
+                        a[j * count + j] += trace * std::numeric_limits <Value>::epsilon ();
+                    }
+                    if (cholesky_solve (std::span { a.data (), count * count }, std::span { gamma.data (), count }))
+                    {
+                        for (auto j = 0u; j < count; ++j)
+                        {
+                            for (auto k = 0u; k < n; ++k)
+                            {
+                                x[k] -= gamma[j] * (dx[j][k] + options.mixing * dr[j][k]);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        count = 0;
+                        newest = 0;
+                    }
+                }
+                r = g (x);
+                for (auto k = 0u; k < n; ++k)
+                {
+                    r[k] -= x[k];
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { x, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    return done (x, false, options.max_iter);
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,402 @@
+#pragma once
+#include "root_finding.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Approximation of the inverse of a monotone function over an interval, to
+// seed newton: y -> x such that f (x) = y, piecewise Chebyshev, with pieces of
+// equal width in y. It is built once (each node is solved with zhang), saved
+// to a binary file, and memory-mapped where it is used.
+//
+// The file is in the native byte order and floating point format: a magic
+// number, sizeof (Value), the number of pieces and the degree (as 64 bits
+// unsigned integers), the range in y, and the coefficients, piece by piece.
+
+    template <class Value>
+    struct
+inverse_options_t
+{
+        std::size_t
+    pieces = 64;
+        std::size_t
+    degree = 8;
+        zhang_options_t <Value, Value>
+    zhang_options = {};
+};
+
+    struct
+inverse_not_monotone_e
+{};
+
+// The file does not exist, or is not a table of this Value type.
+    struct
+inverse_bad_file_e
+{};
+
+// A view on the coefficients, wherever they are.
+    template <class Value>
+    struct
+inverse_view_t
+{
+        Value
+      y_min
+    , y_max
+    ;
+        std::size_t
+      pieces
+    , degree
+    ;
+        std::span <Value const>
+    coefficients;
+
+        Value
+    operator () (Value const& y) const
+    {
+            const auto
+        t = (y - y_min) / (y_max - y_min) * static_cast <Value> (pieces);
+            const auto
+        i = static_cast <std::size_t> (std::clamp (t, Value (0), static_cast <Value> (pieces - 1)));
+        // The position in the piece, in [-1, 1], and Clenshaw's recurrence.
+            const auto
+        u = 2 * (t - static_cast <Value> (i)) - 1;
+            const auto
+        c = coefficients.subspan (i * (degree + 1), degree + 1);
+            auto
+          b1 = Value {}
+        , b2 = Value {}
+        ;
+        for (auto k = degree; k > 0; --k)
+        {
+                const auto
+            b = 2 * u * b1 - b2 + c[k];
+            b2 = b1;
+            b1 = b;
+        }
+        return u * b1 - b2 + c[0];
+    }
+};
+
+    namespace
+inverse_detail
+{
+        constexpr char
+    magic[8] = { 'C', 'R', 'F', 'I', 'N', 'V', '0', '1' };
+
+        struct
+    header_t
+    {
+            char
+        magic[8];
+            std::uint64_t
+          value_size
+        , pieces
+        , degree
+        ;
+    };
+} // namespace inverse_detail
+
+// Owns its coefficients.
+    template <class Value>
+    struct
+inverse_table_t
+{
+        Value
+      y_min
+    , y_max
+    ;
+        std::size_t
+      pieces
+    , degree
+    ;
+        std::vector <Value>
+    coefficients;
+
+        inverse_view_t <Value>
+    view () const
+    {
+        return { y_min, y_max, pieces, degree, coefficients };
+    }
+
+        Value
+    operator () (Value const& y) const
+    {
+        return view () (y);
+    }
+
+        void
+    save (std::string const& path) const
+    {
+            auto
+        header = inverse_detail::header_t { {}, sizeof (Value), pieces, degree };
+        std::memcpy (header.magic, inverse_detail::magic, sizeof header.magic);
+            auto
+        out = std::ofstream { path, std::ios::binary };
+        out.write (reinterpret_cast <char const*> (&header), sizeof header);
+        out.write (reinterpret_cast <char const*> (&y_min), sizeof y_min);
+        out.write (reinterpret_cast <char const*> (&y_max), sizeof y_max);
+        out.write (
+              reinterpret_cast <char const*> (coefficients.data ())
+            , static_cast <std::streamsize> (coefficients.size () * sizeof (Value))
+        );
+        if (!out)
+        {
+            throw inverse_bad_file_e {};
+        }
+    }
+};
+
+// Maps a file written by inverse_table_t::save, read only.
+    template <class Value>
+    class
+mapped_inverse_table_t
+{
+        void*
+    address = nullptr;
+        std::size_t
+    size = 0;
+        inverse_view_t <Value>
+    view_;
+
+    public:
+    explicit
+    mapped_inverse_table_t (std::string const& path)
+    {
+            const auto
+        fd = ::open (path.c_str (), O_RDONLY);
+        if (fd < 0)
+        {
+            throw inverse_bad_file_e {};
+        }
+            struct stat
+        st;
+        if (::fstat (fd, &st) == 0)
+        {
+            size = static_cast <std::size_t> (st.st_size);
+            address = ::mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close (fd);
+        if (address == nullptr || address == MAP_FAILED)
+        {
+            address = nullptr;
+            throw inverse_bad_file_e {};
+        }
+            const auto
+        bytes = static_cast <char const*> (address);
+            auto
+        header = inverse_detail::header_t {};
+            constexpr auto
+        offset = sizeof header + 2 * sizeof (Value);
+        if (size >= offset)
+        {
+            std::memcpy (&header, bytes, sizeof header);
+        }
+        if (
+               size < offset
+            || std::memcmp (header.magic, inverse_detail::magic, sizeof header.magic) != 0
+            || header.value_size != sizeof (Value)
+            || size != offset + header.pieces * (header.degree + 1) * sizeof (Value)
+            || header.pieces == 0
+        ){
+            ::munmap (address, size);
+            throw inverse_bad_file_e {};
+        }
+        std::memcpy (&view_.y_min, bytes + sizeof header, sizeof (Value));
+        std::memcpy (&view_.y_max, bytes + sizeof header + sizeof (Value), sizeof (Value));
+        view_.pieces = header.pieces;
+        view_.degree = header.degree;
+        view_.coefficients = {
+              reinterpret_cast <Value const*> (bytes + offset)
+            , header.pieces * (header.degree + 1)
+        };
+    }
+
+    mapped_inverse_table_t (mapped_inverse_table_t const&) = delete;
+
+        mapped_inverse_table_t&
+    operator = (mapped_inverse_table_t const&) = delete;
+
+    mapped_inverse_table_t (mapped_inverse_table_t&& other) noexcept
+        : address { std::exchange (other.address, nullptr) }
+        , size { other.size }
+        , view_ { other.view_ }
+    {}
+
+    ~mapped_inverse_table_t ()
+    {
+        if (address)
+        {
+            ::munmap (address, size);
+        }
+    }
+
+        inverse_view_t <Value>
+    view () const
+    {
+        return view_;
+    }
+
+        Value
+    operator () (Value const& y) const
+    {
+        return view_ (y);
+    }
+};
+
+// Builds the table of the inverse of function, monotone over [a, b]. Throws
+// inverse_not_monotone_e if it is not: if its values on a uniform grid of as
+// many points as nodes, or the solved nodes, are not in order.
+    template <
+          class Function
+        , class Value
+    >
+    requires std::invocable <Function, Value>
+    auto
+make_inverse_table (
+      Function&& function
+    , Value      a
+    , Value      b
+    , inverse_options_t <Value> const& options = {}
+){
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        const Value
+      fa = function (a)
+    , fb = function (b)
+    ;
+    if (fa == fb)
+    {
+        throw inverse_not_monotone_e {};
+    }
+    // 1 if increasing, -1 if decreasing.
+        const auto
+    direction = Value (fb > fa ? 1 : -1);
+        const auto
+    pieces = std::max (options.pieces, std::size_t { 1 });
+        const auto
+    n = options.degree + 1;
+    // The slope must not change sign between the ends.
+    {
+            const auto
+        samples = pieces * n;
+            auto
+        f_past = fa;
+        for (auto j = 1u; j <= samples; ++j)
+        {
+                const Value
+            f = j == samples ? fb : function (a + (b - a) * static_cast <Value> (j) / static_cast <Value> (samples));
+            if (direction * (f - f_past) < 0)
+            {
+                throw inverse_not_monotone_e {};
+            }
+            f_past = f;
+        }
+    }
+        auto
+    table = inverse_table_t <Value> {
+          std::min (fa, fb)
+        , std::max (fa, fb)
+        , pieces
+        , options.degree
+        , std::vector <Value> (pieces * n)
+    };
+        auto
+    x = std::vector <Value> (n);
+        auto
+    u = std::vector <Value> (n);
+        const auto
+    width = (table.y_max - table.y_min) / static_cast <Value> (pieces);
+    // The node of the largest y so far: x must move in the direction of the
+    // function as y grows, across the pieces too.
+        auto
+    x_past = direction > 0 ? a : b;
+    for (auto i = 0u; i < pieces; ++i)
+    {
+        // The inverse at the Chebyshev nodes of the piece, ...
+        for (auto j = 0u; j < n; ++j)
+        {
+                using std::cos;
+            u[j] = cos (std::numbers::pi_v <Value> * (static_cast <Value> (j) + Value (0.5)) / static_cast <Value> (n));
+                const auto
+            y = table.y_min + width * (static_cast <Value> (i) + (u[j] + 1) / 2);
+                auto
+            g = [&](Value const& v){ return Value (function (v)) - y; };
+            try
+            {
+                x[j] = zhang (g, a, b, options.zhang_options);
+            }
+            catch (zhang_no_single_root_between_brackets_e const&)
+            {
+                throw inverse_not_monotone_e {};
+            }
+        }
+        // The nodes come by decreasing y.
+        for (auto j = n; j-- > 0;)
+        {
+            if (direction * (x[j] - x_past) < 0)
+            {
+                throw inverse_not_monotone_e {};
+            }
+            x_past = x[j];
+        }
+        // ... and its Chebyshev coefficients.
+        for (auto k = 0u; k < n; ++k)
+        {
+                auto
+            c = Value {};
+            for (auto j = 0u; j < n; ++j)
+            {
+                    using std::cos;
+                c += x[j] * cos (std::numbers::pi_v <Value> * static_cast <Value> (k) * (static_cast <Value> (j) + Value (0.5)) / static_cast <Value> (n));
+            }
+            table.coefficients[i * n + k] = c * (k == 0 ? 1 : 2) / static_cast <Value> (n);
+        }
+    }
+    return table;
+}
+
+// Solves function (x) = y with newton, from the approximation of the inverse.
+    template <
+          class Function
+        , class Derivative
+        , class Table
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class DerivativeResult = std::invoke_result_t <Derivative, Value>
+    >
+    requires
+           std::invocable <Function, Value>
+        && std::invocable <Derivative, Value>
+    auto
+newton_inverse (
+      Function&&       function
+    , Derivative&&     derivative
+    , Table const&     table
+    , Value const&     y
+    , newton_options_t <Value, FunctionResult, DerivativeResult> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+    return newton (
+          [&](Value const& x){ return function (x) - y; }
+        , std::forward <Derivative> (derivative)
+        , table (y)
+        , options
+        , info
+    );
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,600 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <optional>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Parallel modes of zhang and golden_section, for functions expensive enough to
+// keep several cores busy: each round evaluates k interior points of the
+// bracket at once, on k threads, and keeps the subinterval where the root (the
+// minimum) is, i.e. shrinks the bracket k + 1 times (for roots, (k + 1) / 2
+// times for minima) per round. Once the bracket is small, the sequential
+// algorithm finishes. The function must be safe to call from several threads.
+// The rounds run on a thread_pool_t, whose workers wait between the rounds
+// rather than being started for each: the one of the options, which can be
+// shared by many calls, or else one started for the call.
+    struct
+KSectionTag
+{};
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+k_section_options_t
+{
+    // Maximum number of rounds.
+        int
+    max_iter = 100;
+    // Interior points per round (k), and threads to evaluate them, unless
+    // there is a pool.
+        unsigned
+    points = default_thread_count ();
+        unsigned
+    threads = default_thread_count ();
+        thread_pool_t*
+    pool = nullptr;
+    // zhang takes over once the function is close enough to linear around the
+    // root: the second difference of the samples there is below linearity
+    // times the first one (never, with 0). zhang then converges in a few
+    // evaluations. Its convergence predicate is also checked after each round,
+    // and its observer is this one.
+        FunctionResult
+    linearity = FunctionResult (0.1);
+        zhang_options_t <Value, FunctionResult>
+    zhang_options = {};
+    // At each evaluation, the iteration being the round, once the round is
+    // done.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+k_section_no_convergence_e = zhang_no_convergence_e;
+
+    using
+k_section_no_single_root_between_brackets_e = zhang_no_single_root_between_brackets_e;
+
+    namespace
+info::data
+{
+        struct
+    k_section_iterations_t
+        : base_iterations_t
+    {
+        // iteration_count is the number of rounds.
+            bool
+        no_single_root_between_bracket = false;
+            int
+        evaluation_count = 0;
+        // Of zhang, if it took over.
+            zhang_iterations_t
+        zhang_info;
+    };
+
+        template <class Value, class FunctionResult>
+        struct
+    k_section_convergence_t
+        : k_section_iterations_t
+    {
+        // The bracket after each round.
+            std::vector <std::tuple <Value, Value, FunctionResult, FunctionResult>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <KSectionTag, tag::iterations, Ts...>
+    {
+            using
+        type = k_section_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <KSectionTag, tag::convergence, Function, Value>
+    {
+            using
+        type = k_section_convergence_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    namespace
+k_section_detail
+{
+    // The k + 2 samples of a round, the ends included.
+        template <class Value, class FunctionResult, class Function, class Observer>
+        void
+    sample (
+          Function& function
+        , Value a
+        , Value b
+        , std::vector <Value>& x
+        , std::vector <FunctionResult>& fx
+        , thread_pool_t& pool
+        , Observer const& observer
+        , char const* solver
+        , int round
+    ){
+            const auto
+        k = x.size () - 2;
+        parallel_for (k, pool, [&](std::size_t j)
+        {
+            x[j + 1] = a + (b - a) * static_cast <Value> (j + 1) / static_cast <Value> (k + 1);
+            fx[j + 1] = function (x[j + 1]);
+        });
+        for (auto j = 1u; j <= k; ++j)
+        {
+            observer (iteration_event_t <Value, FunctionResult> {
+                solver, round, step_t::sampling, x[j], fx[j]
+            });
+        }
+    }
+
+    // The ends, at once.
+        template <class Value, class FunctionResult, class Function, class Observer>
+        void
+    ends (
+          Function& function
+        , Value a
+        , Value b
+        , std::vector <Value>& x
+        , std::vector <FunctionResult>& fx
+        , thread_pool_t& pool
+        , Observer const& observer
+        , char const* solver
+    ){
+            const auto
+        k = x.size () - 2;
+        parallel_for (2, pool, [&](std::size_t j)
+        {
+            x[j * (k + 1)] = j == 0 ? a : b;
+            fx[j * (k + 1)] = function (x[j * (k + 1)]);
+        });
+        observer (iteration_event_t <Value, FunctionResult> { solver, 0, step_t::initial, a, fx.front () });
+        observer (iteration_event_t <Value, FunctionResult> { solver, 0, step_t::initial, b, fx.back () });
+    }
+
+    // The pool of the options, or else one for the call, with no more threads
+    // than points per round.
+        template <class Options>
+        thread_pool_t&
+    pool (Options const& options, std::optional <thread_pool_t>& own, unsigned k)
+    {
+        if (options.pool)
+        {
+            return *options.pool;
+        }
+        return own.emplace (std::clamp (options.threads, 1u, std::max (k, 2u)));
+    }
+} // namespace k_section_detail
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+k_section (
+      Function&& function
+    , Value      a // bracket 1
+    , Value      b // bracket 2
+    , k_section_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          KSectionTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        const auto
+    k = std::max (options.points, 1u);
+        auto
+    x = std::vector <Value> (k + 2);
+        auto
+    fx = std::vector <FunctionResult> (k + 2);
+        auto
+    return_ = [&](Value r, bool converged)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { r, info_data };
+        }
+        else
+        {
+            if (!converged)
+            {
+                throw k_section_no_convergence_e {};
+            }
+            return r;
+        }
+    };
+        auto
+    own_pool = std::optional <thread_pool_t> {};
+        auto&
+    pool = k_section_detail::pool (options, own_pool, k);
+    try
+    {
+        k_section_detail::ends (function, a, b, x, fx, pool, options.observer, "k_section");
+        if constexpr (need_info)
+        {
+            info_data.evaluation_count = 2;
+        }
+            auto
+        fa = fx.front ();
+            auto
+        fb = fx.back ();
+        if (fa * fb > 0)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.no_single_root_between_bracket = true;
+                return std::pair { (a + b) / 2, info_data };
+            }
+            else
+            {
+                throw k_section_no_single_root_between_brackets_e {};
+            }
+        }
+        for (int i = 0; i < options.max_iter; ++i)
+        {
+            if (fa == 0 || fb == 0 || options.zhang_options.converged (a, b, fa, fb))
+            {
+                if constexpr (need_info_iterations)
+                {
+                    info_data.iteration_count = i;
+                }
+                return return_ (fa == 0 ? a : fb == 0 ? b : (a + b) / 2, true);
+            }
+            x.front () = a;
+            x.back () = b;
+            fx.front () = fa;
+            fx.back () = fb;
+            k_section_detail::sample (function, a, b, x, fx, pool, options.observer, "k_section", i + 1);
+            if constexpr (need_info)
+            {
+                info_data.evaluation_count += static_cast <int> (k);
+                info_data.iteration_count = i + 1;
+            }
+            // The first sign change.
+                auto
+            j = 0u;
+            while (fx[j] != 0 && fx[j + 1] != 0 && (fx[j] < 0) == (fx[j + 1] < 0))
+            {
+                ++j;
+            }
+            if (fx[j] == 0 || fx[j + 1] == 0)
+            {
+                return return_ (fx[j] == 0 ? x[j] : x[j + 1], true);
+            }
+            a  = x[j];
+            b  = x[j + 1];
+            fa = fx[j];
+            fb = fx[j + 1];
+            if constexpr (need_info_convergence)
+            {
+                info_data.convergence.push_back ({ a, b, fa, fb });
+            }
+            // Close enough to linear around the root: zhang finishes, from the
+            // bracket.
+                using std::fabs;
+                const auto
+            d2 = j > 0
+                ? fx[j - 1] - 2 * fx[j] + fx[j + 1]
+                : fx[j] - 2 * fx[j + 1] + fx[j + 2]
+            ;
+            if (fabs (d2) < options.linearity * fabs (fb - fa))
+            {
+                    const auto
+                zhang_options = zhang_options_t <
+                      Value
+                    , FunctionResult
+                    , decltype (options.zhang_options.converged)
+                    , Observer
+                > {
+                      options.zhang_options.max_iter
+                    , options.zhang_options.converged
+                    , options.observer
+                };
+                if constexpr (need_info)
+                {
+                        auto
+                    [ r, zi ] = zhang (function, std::tuple { a, b, fa, fb }, zhang_options, info::iterations);
+                    info_data.function_threw = zi.function_threw;
+                    info_data.zhang_info = zi;
+                    return return_ (r, zi.converged);
+                }
+                else
+                {
+                    return zhang (function, std::tuple { a, b, fa, fb }, zhang_options);
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    return return_ ((a + b) / 2, false);
+}
+
+//------------------------------------------------------------------------------
+// Minimum: a uniform search of a unimodal function, the minimum being next to
+// the smallest sample, which golden_section finishes when it needs no more
+// than sequential_evaluations evaluations to reach its tolerance.
+    struct
+KSectionMinimumTag
+{};
+
+    template <class Value, class Observer = no_observer_t>
+    struct
+k_section_minimum_options_t
+{
+        int
+    max_iter = 100;
+    // At least 2.
+        unsigned
+    points = default_thread_count ();
+        unsigned
+    threads = default_thread_count ();
+        thread_pool_t*
+    pool = nullptr;
+        int
+    sequential_evaluations = 8;
+    // Its tolerance is the one of the search, and its observer this one.
+        golden_section_options_t <Value>
+    golden_section_options = {};
+    // As for k_section.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+k_section_minimum_no_convergence_e = golden_section_no_convergence_e;
+
+    namespace
+info::data
+{
+        struct
+    k_section_minimum_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+            golden_section_iterations_t
+        golden_section_info;
+    };
+
+        template <class Value>
+        struct
+    k_section_minimum_convergence_t
+        : k_section_minimum_iterations_t
+    {
+        // The bracket after each round.
+            std::vector <std::pair <Value, Value>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <KSectionMinimumTag, tag::iterations, Ts...>
+    {
+            using
+        type = k_section_minimum_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <KSectionMinimumTag, tag::convergence, Function, Value>
+    {
+            using
+        type = k_section_minimum_convergence_t <Value>;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+k_section_minimum (
+      Function&& function
+    , Value      a
+    , Value      b
+    , k_section_minimum_options_t <Value, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          KSectionMinimumTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        const auto
+    k = std::max (options.points, 2u);
+        auto
+    x = std::vector <Value> (k + 2);
+        auto
+    fx = std::vector <FunctionResult> (k + 2);
+        const auto
+    tolerance = options.golden_section_options.tolerance;
+        auto
+    return_ = [&](Value r, bool converged)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { r, info_data };
+        }
+        else
+        {
+            if (!converged)
+            {
+                throw k_section_minimum_no_convergence_e {};
+            }
+            return r;
+        }
+    };
+        auto
+    own_pool = std::optional <thread_pool_t> {};
+        auto&
+    pool = k_section_detail::pool (options, own_pool, k);
+    try
+    {
+        k_section_detail::ends (function, a, b, x, fx, pool, options.observer, "k_section_minimum");
+        if constexpr (need_info)
+        {
+            info_data.evaluation_count = 2;
+        }
+            auto
+        fa = fx.front ();
+            auto
+        fb = fx.back ();
+        for (int i = 0; i < options.max_iter; ++i)
+        {
+            // Evaluations golden_section would need from here.
+                using std::log;
+                using std::ceil;
+                const auto
+            remaining = b - a <= tolerance ? 0.
+                : ceil (log (tolerance / (b - a)) / log (1. / std::numbers::phi))
+            ;
+            if (remaining <= options.sequential_evaluations)
+            {
+                if constexpr (need_info_iterations)
+                {
+                    info_data.iteration_count = i;
+                }
+                if (remaining == 0)
+                {
+                    return return_ (fa < fb ? a : b, true);
+                }
+                // From [a, c] with c the middle, bracket_minimum finds [a, b]
+                // again, or a narrower bracket.
+                    const auto
+                c = (a + b) / 2;
+                    const auto
+                golden_section_options = golden_section_options_t <Value, Observer> {
+                      options.golden_section_options.tolerance
+                    , options.golden_section_options.bracket_minimum_options
+                    , options.observer
+                };
+                if constexpr (need_info)
+                {
+                        auto
+                    [ r, gi ] = golden_section (function, a, c, golden_section_options, info::iterations);
+                    info_data.function_threw = gi.function_threw;
+                    info_data.golden_section_info = gi;
+                    return return_ (r, gi.converged);
+                }
+                else
+                {
+                    return golden_section (function, a, c, golden_section_options);
+                }
+            }
+            x.front () = a;
+            x.back () = b;
+            fx.front () = fa;
+            fx.back () = fb;
+            k_section_detail::sample (function, a, b, x, fx, pool, options.observer, "k_section_minimum", i + 1);
+            if constexpr (need_info)
+            {
+                info_data.evaluation_count += static_cast <int> (k);
+                info_data.iteration_count = i + 1;
+            }
+                const auto
+            m = static_cast <std::size_t> (std::min_element (fx.begin (), fx.end ()) - fx.begin ());
+                const auto
+            lo = m == 0 ? 0 : m - 1;
+                const auto
+            hi = std::min <std::size_t> (m + 1, k + 1);
+            a  = x[lo];
+            b  = x[hi];
+            fa = fx[lo];
+            fb = fx[hi];
+            if constexpr (need_info_convergence)
+            {
+                info_data.convergence.push_back ({ a, b });
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    return return_ ((a + b) / 2, false);
+}
+} // namespace calculisto::root_finding
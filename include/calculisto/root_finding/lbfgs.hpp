@@ -0,0 +1,543 @@
+#pragma once
+#include "root_finding.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Limited memory BFGS, with a strong Wolfe line search (Nocedal & Wright,
+// "Numerical Optimization", 2nd ed., algorithms 7.4, 3.5 and 3.6).
+//
+// The function is either fused, f (x, gradient) -> value, writing the gradient
+// of f at x in its second argument, or plain, f (x) -> value, in which case the
+// gradient is computed by central finite differences.
+    struct
+LbfgsTag
+{};
+
+    template <class Function, class Point>
+    struct
+value_and_gradient_result
+{
+        using
+    type = std::invoke_result_t <Function, Point>;
+};
+
+    template <class Function, class Point>
+    requires std::invocable <Function, Point const&, Point&>
+    struct
+value_and_gradient_result <Function, Point>
+{
+        using
+    type = std::invoke_result_t <Function, Point const&, Point&>;
+};
+
+    template <class Function, class Point>
+    using
+value_and_gradient_result_t = typename value_and_gradient_result <Function, Point>::type;
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+lbfgs_options_t
+{
+        int
+    max_iter = 1000;
+    // Number of correction pairs kept.
+        int
+    history = 10;
+    // Converged when the largest component of the gradient is below...
+        Value
+    gradient_tolerance = std::sqrt (std::numeric_limits <Value>::epsilon ());
+    // ... or when the relative decrease of the function is below.
+        FunctionResult
+    tolerance = std::numeric_limits <FunctionResult>::epsilon ();
+    // Sufficient decrease and curvature parameters of the Wolfe conditions.
+        Value
+    c1 = 1e-4;
+        Value
+    c2 = 0.9;
+        int
+    max_line_search_iter = 20;
+    // Relative step of the finite differences, when the gradient is not given.
+        Value
+    finite_difference_step = std::cbrt (std::numeric_limits <Value>::epsilon ());
+    // At each evaluation of the value (not for the finite differences).
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+lbfgs_no_convergence_e = defaults::no_convergence_e;
+
+    struct
+lbfgs_line_search_failed_e
+{};
+
+    namespace
+info::data
+{
+        struct
+    lbfgs_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+            bool
+        line_search_failed = false;
+    };
+
+        template <
+              class Point
+            , class FunctionResult
+        >
+        struct
+    lbfgs_convergence_t
+        : lbfgs_iterations_t
+    {
+        // iteration, function value, gradient max-norm, point.
+            std::vector <std::tuple <int, FunctionResult, point_value_t <Point>, Point>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <LbfgsTag, tag::iterations, Ts...>
+    {
+            using
+        type = lbfgs_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Point
+        >
+        struct
+    select <LbfgsTag, tag::convergence, Function, Point>
+    {
+            using
+        type = lbfgs_convergence_t <
+              Point
+            , value_and_gradient_result_t <Function, Point>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , point Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Point>
+        , class FunctionResult = value_and_gradient_result_t <Function, Point>
+        , class Observer = no_observer_t
+    >
+    requires
+           std::invocable <Function, Point const&, Point&>
+        || std::invocable <Function, Point>
+    auto
+lbfgs (
+      Function&&   function
+    , Point const& init
+    , lbfgs_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          LbfgsTag
+        , InfoTag
+        , Function
+        , Point
+    > {};
+
+        const auto
+    n = init.size ();
+        const auto
+    m = static_cast <std::size_t> (std::max (options.history, 1));
+    // All the storage is allocated once, here: the correction pairs are kept
+    // in a circular buffer.
+        auto
+    s = std::vector <Point> (m, init);
+        auto
+    y = std::vector <Point> (m, init);
+        auto
+    rho = std::vector <Value> (m);
+        auto
+    alpha = std::vector <Value> (m);
+        std::size_t
+      newest = 0
+    , count  = 0
+    ;
+        auto
+    x = init;
+        auto
+    g = init;
+        auto
+    d = init;
+        auto
+    x_new = init;
+        auto
+    g_new = init;
+        [[maybe_unused]]
+        auto
+    x_h = init;
+
+        auto
+    iteration = 0;
+        auto
+    observe = [&](Point const& p, FunctionResult const& f)
+    {
+        options.observer (iteration_event_t <Point, FunctionResult> {
+              "lbfgs"
+            , iteration
+            , iteration == 0 ? step_t::initial : step_t::line_search
+            , p
+            , f
+        });
+        return f;
+    };
+        auto
+    value_and_gradient = [&](Point const& p, Point& gradient) -> FunctionResult
+    {
+        if constexpr (std::invocable <Function, Point const&, Point&>)
+        {
+            if constexpr (need_info)
+            {
+                ++info_data.evaluation_count;
+            }
+            return observe (p, function (p, gradient));
+        }
+        else
+        {
+            if constexpr (need_info)
+            {
+                info_data.evaluation_count += 2 * n + 1;
+            }
+                using std::fabs;
+            x_h = p;
+            for (auto k = 0u; k < n; ++k)
+            {
+                    const auto
+                h = options.finite_difference_step * std::max (Value (1), fabs (p[k]));
+                x_h[k] = p[k] + h;
+                    const auto
+                f_plus = function (x_h);
+                x_h[k] = p[k] - h;
+                    const auto
+                f_minus = function (x_h);
+                x_h[k] = p[k];
+                gradient[k] = (f_plus - f_minus) / (2 * h);
+            }
+            return observe (p, function (p));
+        }
+    };
+        auto
+    max_norm = [&](Point const& v)
+    {
+            using std::fabs;
+            auto
+        r = Value {};
+        for (auto k = 0u; k < n; ++k)
+        {
+            r = std::max (r, Value (fabs (v[k])));
+        }
+        return r;
+    };
+        auto
+    return_ = [&](bool converged)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { x, info_data };
+        }
+        else
+        {
+            return x;
+        }
+    };
+        FunctionResult
+    f;
+    try
+    {
+        f = value_and_gradient (x, g);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.function_threw = true;
+            return return_ (false);
+        }
+        else
+        {
+            throw;
+        }
+    }
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+        iteration = i + 1;
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = i;
+        }
+        if (max_norm (g) <= options.gradient_tolerance)
+        {
+            return return_ (true);
+        }
+        // Two-loop recursion: d = -H g.
+        for (auto k = 0u; k < n; ++k)
+        {
+            d[k] = -g[k];
+        }
+        for (auto j = 0u; j < count; ++j)
+        {
+                const auto
+            l = (newest + m - j) % m;
+            alpha[l] = rho[l] * dot (s[l], d);
+            for (auto k = 0u; k < n; ++k)
+            {
+                d[k] -= alpha[l] * y[l][k];
+            }
+        }
+            auto
+        gamma = Value (1);
+        if (count > 0)
+        {
+            gamma = dot (s[newest], y[newest]) / dot (y[newest], y[newest]);
+        }
+        else
+        {
+            // First step: don't go further than a unit distance.
+            gamma = std::min (Value (1), 1 / max_norm (g));
+        }
+        for (auto k = 0u; k < n; ++k)
+        {
+            d[k] *= gamma;
+        }
+        for (auto j = count; j-- > 0;)
+        {
+                const auto
+            l = (newest + m - j) % m;
+                const auto
+            beta = rho[l] * dot (y[l], d);
+            for (auto k = 0u; k < n; ++k)
+            {
+                d[k] += s[l][k] * (alpha[l] - beta);
+            }
+        }
+            auto
+        dphi0 = dot (g, d);
+        if (!(dphi0 < 0))
+        {
+            // Not a descent direction: restart from steepest descent.
+            count = 0;
+            for (auto k = 0u; k < n; ++k)
+            {
+                d[k] = -g[k] / std::max (Value (1), max_norm (g));
+            }
+            dphi0 = dot (g, d);
+        }
+        // Line search, along d, for a step satisfying the strong Wolfe
+        // conditions. On exit, x_new, g_new and f_new are at the chosen step.
+            FunctionResult
+        f_new;
+            Value
+        dphi;
+            auto
+        phi = [&](Value a)
+        {
+            for (auto k = 0u; k < n; ++k)
+            {
+                x_new[k] = x[k] + a * d[k];
+            }
+            f_new = value_and_gradient (x_new, g_new);
+            dphi  = dot (g_new, d);
+        };
+            auto
+        sufficient_decrease = [&](Value a)
+        {
+            return f_new <= f + options.c1 * a * dphi0;
+        };
+            auto
+        curvature = [&]
+        {
+                using std::fabs;
+            return fabs (dphi) <= -options.c2 * dphi0;
+        };
+            bool
+        found = false;
+        try
+        {
+                Value
+              a_lo    = 0
+            , a_hi    = 0
+            , a       = 1
+            ;
+                FunctionResult
+              f_lo  = f
+            , f_hi  = f
+            ;
+                Value
+              dphi_lo = dphi0
+            , dphi_hi = dphi0
+            ;
+                bool
+            zoom = false;
+            for (int j = 0; j < options.max_line_search_iter && !found; ++j)
+            {
+                if (zoom)
+                {
+                    // Cubic interpolation, safeguarded by bisection.
+                        using std::sqrt;
+                        using std::fabs;
+                        const auto
+                    d1 = dphi_lo + dphi_hi - 3 * (f_lo - f_hi) / (a_lo - a_hi);
+                        const auto
+                    d2_2 = d1 * d1 - dphi_lo * dphi_hi;
+                        const auto
+                    lo = std::min (a_lo, a_hi);
+                        const auto
+                    hi = std::max (a_lo, a_hi);
+                    a = (a_lo + a_hi) / 2;
+                    if (d2_2 >= 0)
+                    {
+                            const auto
+                        d2 = (a_hi > a_lo ? 1 : -1) * sqrt (d2_2);
+                            const auto
+                        c = a_hi - (a_hi - a_lo) * (dphi_hi + d2 - d1)
+                            / (dphi_hi - dphi_lo + 2 * d2);
+                        if (c > lo + (hi - lo) / 10 && c < hi - (hi - lo) / 10)
+                        {
+                            a = c;
+                        }
+                    }
+                }
+                phi (a);
+                if (!sufficient_decrease (a) || (zoom ? f_new >= f_lo : (j > 0 && f_new >= f_lo)))
+                {
+                    if (!zoom)
+                    {
+                        // a_lo is the previous step.
+                        zoom = true;
+                    }
+                    a_hi    = a;
+                    f_hi    = f_new;
+                    dphi_hi = dphi;
+                    continue;
+                }
+                if (curvature ())
+                {
+                    found = true;
+                    continue;
+                }
+                if (zoom)
+                {
+                    if (dphi * (a_hi - a_lo) >= 0)
+                    {
+                        a_hi    = a_lo;
+                        f_hi    = f_lo;
+                        dphi_hi = dphi_lo;
+                    }
+                }
+                else if (dphi >= 0)
+                {
+                    zoom    = true;
+                    a_hi    = a_lo;
+                    f_hi    = f_lo;
+                    dphi_hi = dphi_lo;
+                }
+                a_lo    = a;
+                f_lo    = f_new;
+                dphi_lo = dphi;
+                if (!zoom)
+                {
+                    a *= 2;
+                }
+            }
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.function_threw = true;
+                return return_ (false);
+            }
+            else
+            {
+                throw;
+            }
+        }
+        if (!found)
+        {
+            if constexpr (need_info)
+            {
+                info_data.line_search_failed = true;
+                return return_ (false);
+            }
+            else
+            {
+                throw lbfgs_line_search_failed_e {};
+            }
+        }
+        // Store the correction pair (s, y), overwriting the oldest one.
+            const auto
+        l = count == 0 ? newest : (newest + 1) % m;
+        for (auto k = 0u; k < n; ++k)
+        {
+            s[l][k] = x_new[k] - x[k];
+            y[l][k] = g_new[k] - g[k];
+        }
+            const auto
+        sy = dot (s[l], y[l]);
+        if (sy > std::numeric_limits <Value>::epsilon () * dot (y[l], y[l]))
+        {
+            rho[l] = 1 / sy;
+            newest = l;
+            count  = std::min (count + 1, m);
+        }
+        else
+        {
+            // Skipped, but the oldest pair, if any, was overwritten.
+            count = std::min (count, m - 1);
+        }
+            using std::swap;
+        swap (x, x_new);
+        swap (g, g_new);
+            using std::fabs;
+            const auto
+        decrease = (f - f_new) / std::max ({ FunctionResult (fabs (f)), FunctionResult (fabs (f_new)), FunctionResult (1) });
+        f = f_new;
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({ i, f, max_norm (g), x });
+        }
+        if (decrease <= options.tolerance)
+        {
+            return return_ (true);
+        }
+    }
+    if constexpr (need_info)
+    {
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = options.max_iter;
+        }
+        return return_ (false);
+    }
+    else
+    {
+        throw lbfgs_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
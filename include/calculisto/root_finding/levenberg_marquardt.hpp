@@ -0,0 +1,488 @@
+#pragma once
+#include "root_finding.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Levenberg-Marquardt, for nonlinear least squares: minimizes
+// 1/2 sum r_i (x)^2 over x.
+//
+// The residuals are computed in place by residuals (x, r), with r a
+// std::span <Value> of size m. The Jacobian, if given, is computed in place by
+// jacobian (x, J), with J a row-major m x n std::span <Value>,
+// J[i * n + k] = d r_i / d x_k. Otherwise it is computed by forward finite
+// differences.
+//
+// The damping is scaled by the diagonal of J^T J (Marquardt) and updated from
+// the gain ratio (Nielsen, "Damping parameter in Marquardt's method", 1999).
+    struct
+LevenbergMarquardtTag
+{};
+
+// Pass this as the Jacobian to use finite differences.
+    struct
+finite_differences_t
+{};
+    constexpr auto
+finite_differences = finite_differences_t {};
+
+// Everything the solver needs, besides the point. Can be passed in the options
+// to be reused from call to call: it is then only resized.
+    template <class Value>
+    struct
+levenberg_marquardt_workspace_t
+{
+        std::vector <Value>
+      r
+    , r_new
+    , jacobian
+    , jtj
+    , jtr
+    , a
+    , dx
+    , scale
+    ;
+        void
+    resize (std::size_t m, std::size_t n)
+    {
+        r.resize (m);
+        r_new.resize (m);
+        jacobian.resize (m * n);
+        jtj.resize (n * n);
+        jtr.resize (n);
+        a.resize (n * n);
+        dx.resize (n);
+        scale.resize (n);
+    }
+};
+
+    template <class Value, class Observer = no_observer_t>
+    struct
+levenberg_marquardt_options_t
+{
+        int
+    max_iter = 100;
+    // Converged when the relative decrease of the cost is below...
+        Value
+    tolerance = std::numeric_limits <Value>::epsilon ();
+    // ... or the relative step is below...
+        Value
+    x_tolerance = std::sqrt (std::numeric_limits <Value>::epsilon ());
+    // ... or the largest component of the gradient J^T r is below.
+        Value
+    gradient_tolerance = std::numeric_limits <Value>::epsilon ();
+        Value
+    initial_damping = 1e-3;
+    // Relative step of the finite differences, when the Jacobian is not given.
+        Value
+    finite_difference_step = std::sqrt (std::numeric_limits <Value>::epsilon ());
+        levenberg_marquardt_workspace_t <Value>*
+    workspace = nullptr;
+    // At each evaluation of the cost (not for the finite differences), with
+    // the cost as f.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+levenberg_marquardt_no_convergence_e = defaults::no_convergence_e;
+
+    namespace
+info::data
+{
+        struct
+    levenberg_marquardt_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+            int
+        jacobian_count = 0;
+            bool
+        jacobian_threw = false;
+    };
+
+        template <class Point>
+        struct
+    levenberg_marquardt_convergence_t
+        : levenberg_marquardt_iterations_t
+    {
+        // iteration, cost, damping, point.
+            std::vector <std::tuple <
+                  int
+                , point_value_t <Point>
+                , point_value_t <Point>
+                , Point
+            >>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <LevenbergMarquardtTag, tag::iterations, Ts...>
+    {
+            using
+        type = levenberg_marquardt_iterations_t;
+    };
+
+        template <class Point>
+        struct
+    select <LevenbergMarquardtTag, tag::convergence, Point>
+    {
+            using
+        type = levenberg_marquardt_convergence_t <Point>;
+    };
+} // namespace info::data
+
+    template <
+          class Residuals
+        , class Jacobian
+        , point Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Point>
+        , class Observer = no_observer_t
+    >
+    requires
+           std::invocable <Residuals, Point const&, std::span <Value>&>
+        && (   std::same_as <std::remove_cvref_t <Jacobian>, finite_differences_t>
+            || std::invocable <Jacobian, Point const&, std::span <Value>&>)
+    auto
+levenberg_marquardt (
+      Residuals&&  residuals
+    , Jacobian&&   jacobian
+    , Point const& init
+    , std::size_t  m
+    , levenberg_marquardt_options_t <Value, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+        constexpr static auto
+    use_finite_differences = std::same_as <std::remove_cvref_t <Jacobian>, finite_differences_t>;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          LevenbergMarquardtTag
+        , InfoTag
+        , Point
+    > {};
+
+        const auto
+    n = init.size ();
+        auto
+    local_workspace = levenberg_marquardt_workspace_t <Value> {};
+        auto&
+    w = options.workspace ? *options.workspace : local_workspace;
+    w.resize (m, n);
+        auto
+    r = std::span <Value> { w.r };
+        auto
+    r_new = std::span <Value> { w.r_new };
+        auto
+    J = std::span <Value> { w.jacobian };
+        auto
+    x = init;
+        auto
+    x_new = init;
+        auto
+    iteration = 0;
+        auto
+    evaluate = [&](Point const& p, std::span <Value>& residual)
+    {
+        if constexpr (need_info)
+        {
+            ++info_data.evaluation_count;
+        }
+        residuals (p, residual);
+            auto
+        cost = Value {};
+        for (auto v: residual)
+        {
+            cost += v * v;
+        }
+        cost /= 2;
+        options.observer (iteration_event_t <Point, Value> {
+              "levenberg_marquardt"
+            , iteration
+            , iteration == 0 ? step_t::initial : step_t::levenberg_marquardt
+            , p
+            , cost
+        });
+        return cost;
+    };
+        auto
+    return_ = [&](bool converged)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { x, info_data };
+        }
+        else
+        {
+            return x;
+        }
+    };
+        Value
+    cost;
+    try
+    {
+        cost = evaluate (x, r);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.function_threw = true;
+            return return_ (false);
+        }
+        else
+        {
+            throw;
+        }
+    }
+        auto
+    lambda = Value {};
+        auto
+    nu = Value (2);
+    std::fill (w.scale.begin (), w.scale.end (), Value {});
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+        iteration = i + 1;
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = i;
+        }
+        // Jacobian at x.
+        try
+        {
+            if constexpr (use_finite_differences)
+            {
+                    using std::fabs;
+                x_new = x;
+                for (auto k = 0u; k < n; ++k)
+                {
+                        const auto
+                    h = options.finite_difference_step * std::max (Value (1), Value (fabs (x[k])));
+                    x_new[k] = x[k] + h;
+                    // Residuals only: a difference is no step to observe.
+                    if constexpr (need_info)
+                    {
+                        ++info_data.evaluation_count;
+                    }
+                    residuals (x_new, r_new);
+                    x_new[k] = x[k];
+                    for (auto j = 0u; j < m; ++j)
+                    {
+                        J[j * n + k] = (r_new[j] - r[j]) / h;
+                    }
+                }
+            }
+            else
+            {
+                if constexpr (need_info)
+                {
+                    ++info_data.jacobian_count;
+                }
+                jacobian (x, J);
+            }
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                if constexpr (use_finite_differences)
+                {
+                    info_data.function_threw = true;
+                }
+                else
+                {
+                    info_data.jacobian_threw = true;
+                }
+                return return_ (false);
+            }
+            else
+            {
+                throw;
+            }
+        }
+        // Normal equations, J^T J and J^T r, built in place.
+        for (auto k = 0u; k < n; ++k)
+        {
+            for (auto l = 0u; l <= k; ++l)
+            {
+                    auto
+                s = Value {};
+                for (auto j = 0u; j < m; ++j)
+                {
+                    s += J[j * n + k] * J[j * n + l];
+                }
+                w.jtj[k * n + l] = s;
+                w.jtj[l * n + k] = s;
+            }
+                auto
+            s = Value {};
+            for (auto j = 0u; j < m; ++j)
+            {
+                s += J[j * n + k] * r[j];
+            }
+            w.jtr[k] = s;
+            w.scale[k] = std::max (w.scale[k], w.jtj[k * n + k]);
+        }
+            using std::fabs;
+            auto
+        g_max = Value {};
+        for (auto k = 0u; k < n; ++k)
+        {
+            g_max = std::max (g_max, Value (fabs (w.jtr[k])));
+        }
+        if (g_max <= options.gradient_tolerance || cost == 0)
+        {
+            return return_ (true);
+        }
+        if (i == 0)
+        {
+            lambda = options.initial_damping;
+        }
+        // Damped steps, until one decreases the cost.
+        for (;;)
+        {
+            std::copy (w.jtj.begin (), w.jtj.end (), w.a.begin ());
+            for (auto k = 0u; k < n; ++k)
+            {
+                w.a[k * n + k] += lambda * std::max (w.scale[k], std::numeric_limits <Value>::min ());
+                w.dx[k] = -w.jtr[k];
+            }
+            if (!cholesky_solve (std::span <Value> { w.a }, std::span <Value> { w.dx }))
+            {
+                lambda *= nu;
+                nu *= 2;
+                if (!std::isfinite (lambda))
+                {
+                    break;
+                }
+                continue;
+            }
+                auto
+            dx_norm = Value {};
+                auto
+            x_norm = Value {};
+            for (auto k = 0u; k < n; ++k)
+            {
+                x_new[k] = x[k] + w.dx[k];
+                dx_norm += w.dx[k] * w.dx[k];
+                x_norm += x[k] * x[k];
+            }
+                using std::sqrt;
+            if (sqrt (dx_norm) <= options.x_tolerance * (sqrt (x_norm) + options.x_tolerance))
+            {
+                return return_ (true);
+            }
+                Value
+            cost_new;
+            try
+            {
+                cost_new = evaluate (x_new, r_new);
+            }
+            catch (...)
+            {
+                if constexpr (need_info)
+                {
+                    info_data.function_threw = true;
+                    return return_ (false);
+                }
+                else
+                {
+                    throw;
+                }
+            }
+            // Gain ratio: actual over predicted decrease.
+                auto
+            predicted = Value {};
+            for (auto k = 0u; k < n; ++k)
+            {
+                predicted += w.dx[k] * (lambda * std::max (w.scale[k], std::numeric_limits <Value>::min ()) * w.dx[k] - w.jtr[k]);
+            }
+            predicted /= 2;
+                const auto
+            rho = (cost - cost_new) / predicted;
+            if (rho > 0 && std::isfinite (cost_new))
+            {
+                    const auto
+                t = 2 * rho - 1;
+                lambda *= std::max (Value (1) / 3, 1 - t * t * t);
+                nu = 2;
+                    const auto
+                decrease = cost - cost_new;
+                    using std::swap;
+                swap (x, x_new);
+                swap (r, r_new);
+                cost = cost_new;
+                if constexpr (need_info_convergence)
+                {
+                    info_data.convergence.push_back ({ i, cost, lambda, x });
+                }
+                if (decrease <= options.tolerance * cost)
+                {
+                    return return_ (true);
+                }
+                break;
+            }
+            lambda *= nu;
+            nu *= 2;
+            if (!std::isfinite (lambda))
+            {
+                break;
+            }
+        }
+        if (!std::isfinite (lambda))
+        {
+            break;
+        }
+    }
+    if constexpr (need_info)
+    {
+        return return_ (false);
+    }
+    else
+    {
+        throw levenberg_marquardt_no_convergence_e {};
+    }
+}
+
+    template <
+          class Residuals
+        , point Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Point>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Residuals, Point const&, std::span <Value>&>
+    auto
+levenberg_marquardt (
+      Residuals&&  residuals
+    , Point const& init
+    , std::size_t  m
+    , levenberg_marquardt_options_t <Value, Observer> const& options = {}
+    , info_t <InfoTag> info = info::none
+){
+    return levenberg_marquardt (
+          std::forward <Residuals> (residuals)
+        , finite_differences
+        , init
+        , m
+        , options
+        , info
+    );
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,323 @@
+#pragma once
+#include "root_finding.hpp"
+#include "bracketing.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Mixed precision: most of the iterations in a cheap type, Low (float by
+// default), then a few in the type of the guess (the brackets), e.g. double or
+// long double, to polish the root. The function (and the derivative) must be
+// callable with both, e.g. a generic lambda. If the iterations in Low fail, or
+// the polish does not converge in polish_iter iterations, the solve starts
+// again in the type of the guess, with max_iter iterations.
+    template <class Tag>
+    struct
+MixedPrecisionTag
+{};
+
+    template <class Low>
+    struct
+mixed_precision_options_t
+{
+    // The iterations in Low, until the relative step (the relative width of
+    // the bracket, for zhang) is below tolerance, ...
+        int
+    max_iter = 100;
+        Low
+    tolerance = 4 * std::numeric_limits <Low>::epsilon ();
+    // ... then at most polish_iter iterations.
+        int
+    polish_iter = 3;
+};
+
+    namespace
+info::data
+{
+        template <class LowInfo, class HighInfo>
+        struct
+    mixed_precision_t
+        : base_t
+    {
+            LowInfo
+        low_info;
+        // Of the last solve in the type of the guess.
+            HighInfo
+        high_info;
+    };
+
+        template <class Tag, class Low, class High, class... Ts>
+        struct
+    select <MixedPrecisionTag <Tag>, tag::iterations, Low, High, Ts...>
+    {
+            using
+        type = mixed_precision_t <
+              select_t <Tag, tag::iterations, Ts..., Low>
+            , select_t <Tag, tag::iterations, Ts..., High>
+        >;
+    };
+
+        template <class Tag, class Low, class High, class... Ts>
+        struct
+    select <MixedPrecisionTag <Tag>, tag::convergence, Low, High, Ts...>
+    {
+            using
+        type = mixed_precision_t <
+              select_t <Tag, tag::convergence, Ts..., Low>
+            , select_t <Tag, tag::convergence, Ts..., High>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Low = float
+        , class Function
+        , class Derivative
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class DerivativeResult = std::invoke_result_t <Derivative, Value>
+    >
+    requires
+           std::invocable <Function, Low>
+        && std::invocable <Derivative, Low>
+        && std::invocable <Function, Value>
+        && std::invocable <Derivative, Value>
+    auto
+newton_mixed (
+      Function&&       function
+    , Derivative&&     derivative
+    , Value const&     initial_guess
+    , mixed_precision_options_t <Low> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = InfoTag != info::tag::none;
+    // The solves in both types need an info, to know if they converged.
+        constexpr static auto
+    sub_tag = need_info_convergence ? info::tag::convergence : info::tag::iterations;
+        constexpr static auto
+    sub_info = info_t <sub_tag> {};
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          MixedPrecisionTag <NewtonTag>
+        , InfoTag
+        , Low
+        , Value
+        , Function
+        , Derivative
+    > {};
+
+        auto
+    [ low, low_info ] = newton (
+          function
+        , derivative
+        , static_cast <Low> (initial_guess)
+        , newton_options_t <Low, std::invoke_result_t <Function, Low>, std::invoke_result_t <Derivative, Low>> {
+              .max_iter = options.max_iter
+            , .converged = make_newton_simple_converged (options.tolerance)
+          }
+        , sub_info
+    );
+        using std::isfinite;
+        const auto
+    start = low_info.converged && isfinite (low) ? static_cast <Value> (low) : initial_guess;
+        using
+    high_options_t = newton_options_t <Value, FunctionResult, DerivativeResult>;
+    if constexpr (need_info)
+    {
+            auto
+        [ polished, high_info ] = newton (
+              function
+            , derivative
+            , start
+            , high_options_t { .max_iter = options.polish_iter }
+            , sub_info
+        );
+        if (
+               !high_info.converged
+            && !high_info.function_threw
+            && !high_info.derivative_threw
+            && !high_info.zero_derivative
+        ){
+                auto
+            [ r, in ] = newton (
+                  function
+                , derivative
+                , start
+                , high_options_t { .max_iter = options.max_iter }
+                , sub_info
+            );
+            polished = r;
+            high_info = std::move (in);
+        }
+        info_data.converged = high_info.converged;
+        info_data.function_threw = high_info.function_threw;
+        info_data.low_info = std::move (low_info);
+        info_data.high_info = std::move (high_info);
+        return std::pair { polished, info_data };
+    }
+    else
+    {
+        try
+        {
+            return newton (function, derivative, start, high_options_t { .max_iter = options.polish_iter });
+        }
+        catch (newton_no_convergence_e const&)
+        {}
+        return newton (
+              std::forward <Function> (function)
+            , std::forward <Derivative> (derivative)
+            , start
+            , high_options_t { .max_iter = options.max_iter }
+        );
+    }
+}
+
+    template <
+          class Low = float
+        , class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+    >
+    requires
+           std::invocable <Function, Low>
+        && std::invocable <Function, Value>
+    auto
+zhang_mixed (
+      Function&& function
+    , Value      a // bracket 1
+    , Value      b // bracket 2
+    , mixed_precision_options_t <Low> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = InfoTag != info::tag::none;
+    // The solves in both types need an info, to know if they converged.
+        constexpr static auto
+    sub_tag = need_info_convergence ? info::tag::convergence : info::tag::iterations;
+        constexpr static auto
+    sub_info = info_t <sub_tag> {};
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          MixedPrecisionTag <ZhangTag>
+        , InfoTag
+        , Low
+        , Value
+        , Function
+    > {};
+
+        using
+    low_result_t = std::invoke_result_t <Function, Low>;
+        const auto
+    tolerance = options.tolerance;
+        auto
+    [ low, low_info ] = zhang (
+          function
+        , static_cast <Low> (a)
+        , static_cast <Low> (b)
+        , zhang_options_t <Low, low_result_t> {
+              .max_iter = options.max_iter
+            , .converged = [=](Low const& u, Low const& v, low_result_t const& fu, low_result_t const& fv)
+              {
+                    using std::fabs;
+                return fu == 0 || fv == 0
+                    || fabs (v - u) <= tolerance * std::max ({ Low (1), Low (fabs (u)), Low (fabs (v)) });
+              }
+          }
+        , sub_info
+    );
+    // A bracket around the root in Low, if it is one in the type of the
+    // guess, to polish the root with chandrupatla, which, unlike zhang,
+    // narrows both ends of the bracket.
+        using
+    high_options_t = zhang_options_t <Value, FunctionResult>;
+        auto
+    polished = (a + b) / 2;
+        auto
+    high_info = info::data::select_t <ZhangTag, sub_tag, Function, Value> {};
+    high_info.converged = false;
+        using std::isfinite;
+    if (low_info.converged && isfinite (low))
+    {
+            using std::fabs;
+            const auto
+        r = static_cast <Value> (low);
+            const auto
+        w = static_cast <Value> (tolerance) * std::max (Value (1), Value (fabs (r)));
+            const auto
+          u = std::max (std::min (a, b), r - w)
+        , v = std::min (std::max (a, b), r + w)
+        ;
+        if constexpr (need_info)
+        {
+                auto
+            [ p, in ] = chandrupatla (
+                  function
+                , u
+                , v
+                , high_options_t { .max_iter = options.polish_iter }
+                , sub_info
+            );
+            polished = p;
+            high_info = std::move (in);
+        }
+        else
+        {
+            try
+            {
+                return chandrupatla (function, u, v, high_options_t { .max_iter = options.polish_iter });
+            }
+            catch (chandrupatla_no_single_root_between_brackets_e const&)
+            {}
+            catch (chandrupatla_no_convergence_e const&)
+            {}
+        }
+    }
+    // Otherwise, all in the type of the guess.
+    if constexpr (need_info)
+    {
+        if (!high_info.converged)
+        {
+                auto
+            [ r, in ] = zhang (
+                  function
+                , a
+                , b
+                , high_options_t { .max_iter = options.max_iter }
+                , sub_info
+            );
+            polished = r;
+            high_info = std::move (in);
+        }
+        info_data.converged = high_info.converged;
+        info_data.function_threw = high_info.function_threw;
+        info_data.low_info = std::move (low_info);
+        info_data.high_info = std::move (high_info);
+        return std::pair { polished, info_data };
+    }
+    else
+    {
+        return zhang (
+              std::forward <Function> (function)
+            , a
+            , b
+            , high_options_t { .max_iter = options.max_iter }
+        );
+    }
+}
+} // namespace calculisto::root_finding
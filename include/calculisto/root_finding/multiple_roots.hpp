@@ -0,0 +1,289 @@
+#pragma once
+#include "root_finding.hpp"
+#include <cmath>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Newton for roots of multiplicity m > 1, where newton converges only
+// linearly: the step is m f / f', with m estimated from the iterates. Near a
+// root of multiplicity m, u = f / f' ~ (x - root) / m, so after a step of
+// m' u, u is multiplied by 1 - m' / m, which gives m. The estimate, rounded,
+// is used once two iterations in a row agree on it. For a simple root, it is
+// newton. The same convergence predicate, exceptions and info as newton, plus
+// the multiplicity. Near a multiple root, the function is only known to
+// within its rounding errors, so that the root is only accurate to about
+// epsilon^(1/m), unless the function is computed in a factored form: a looser
+// convergence predicate (make_newton_simple_converged) may then be needed.
+    struct
+NewtonMultipleTag
+{};
+
+    template <
+          class Value
+        , class FunctionResult
+        , class Observer = no_observer_t
+    >
+    struct
+newton_multiple_options_t
+{
+        int
+    max_iter = 100;
+        std::function <bool (
+          Value const&
+        , Value const&
+        , FunctionResult const&
+    )>
+    converged = &newton_default_converged <Value, FunctionResult>;
+        int
+    max_multiplicity = 16;
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    namespace
+info::data
+{
+        struct
+    newton_multiple_iterations_t
+        : newton_iterations_t
+    {
+        // The last estimate.
+            int
+        multiplicity = 1;
+    };
+
+        template <
+              class Value
+            , class FunctionResult
+            , class DerivativeResult
+        >
+        struct
+    convergence_newton_multiple_t
+        : convergence_newton_t <Value, FunctionResult, DerivativeResult>
+    {
+            int
+        multiplicity = 1;
+        // The multiplicity used for each step of convergence.
+            std::vector <int>
+        multiplicities;
+    };
+
+        template <class... Ts>
+        struct
+    select <NewtonMultipleTag, tag::iterations, Ts...>
+    {
+            using
+        type = newton_multiple_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Derivative
+            , class Value
+        >
+        struct
+    select <NewtonMultipleTag, tag::convergence, Function, Derivative, Value>
+    {
+            using
+        type = convergence_newton_multiple_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+            , std::invoke_result_t <Derivative, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Derivative
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class DerivativeResult = std::invoke_result_t <Derivative, Value>
+        , class Observer = no_observer_t
+    >
+    requires
+           std::invocable <Function, Value>
+        && std::invocable <Derivative, Value>
+    auto
+newton_multiple (
+      Function&&       function
+    , Derivative&&     derivative
+    , Value const&     initial_guess
+    , newton_multiple_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          NewtonMultipleTag
+        , InfoTag
+        , Function
+        , Derivative
+        , Value
+    > {};
+
+        Value
+    past;
+        Value
+    current = initial_guess;
+    // The multiplicity of the last step, and the last estimate.
+        int
+      m = 1
+    , candidate = 1
+    ;
+        auto
+    u_past = Value {};
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+            auto
+        f = FunctionResult {};
+        try
+        {
+            f = std::forward <Function> (function) (current);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.function_threw = true;
+                info_data.multiplicity = m;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "newton_multiple"
+            , i
+            , i == 0 ? step_t::initial : step_t::newton
+            , current
+            , f
+        });
+        // At a multiple root, f' is 0 too.
+        if (f == 0)
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            if constexpr (need_info)
+            {
+                info_data.multiplicity = m;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                return current;
+            }
+        }
+            auto
+        df = DerivativeResult {};
+        try
+        {
+            df = std::forward <Derivative> (derivative) (current);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.derivative_threw = true;
+                info_data.multiplicity = m;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        if (df == 0.)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.zero_derivative = true;
+                info_data.multiplicity = m;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw newton_zero_derivative_e {};
+            }
+        }
+            const auto
+        u = Value (f / df);
+        if (i > 0 && u_past != 0)
+        {
+                using std::round;
+                const auto
+            estimate = round (m / (1 - u / u_past));
+            // Not for a NaN f or df, or two equal steps.
+            if (std::isfinite (estimate))
+            {
+                    const auto
+                rounded = estimate < 1
+                    ? 1
+                    : estimate > options.max_multiplicity
+                    ? options.max_multiplicity
+                    : static_cast <int> (estimate)
+                ;
+                if (rounded == candidate)
+                {
+                    m = rounded;
+                }
+                candidate = rounded;
+            }
+        }
+        u_past = u;
+        past = current;
+        current -= m * u;
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({current, f, df});
+            info_data.multiplicities.push_back (m);
+        }
+        if (options.converged (current, past, f))
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            if constexpr (need_info)
+            {
+                info_data.multiplicity = m;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                return current;
+            }
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.converged = false;
+        info_data.multiplicity = m;
+        return std::pair { current, info_data };
+    }
+    else
+    {
+        throw newton_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
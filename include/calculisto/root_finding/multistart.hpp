@@ -0,0 +1,328 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <mutex>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Global minimization in a box: powell from many starting points, spread by a
+// Halton sequence, in parallel. Each start runs a few iterations first, and is
+// dropped if it is then in the basin of a minimum already found (closer to it
+// than basin_radius). The distinct minima are returned best first. Which
+// starts are dropped depends on the order they end in, hence on the threads.
+// The function must be safe to call from several threads.
+    struct
+MultistartTag
+{};
+
+// The i-th point (from 0) of the Halton sequence in [0, 1)^dimension, from 1,
+// since 0 is the corner of the box.
+    template <class Value>
+    std::valarray <Value>
+halton (std::size_t i, std::size_t dimension)
+{
+        auto
+    x = std::valarray <Value> (dimension);
+        auto
+    prime = std::size_t { 1 };
+    for (auto d = 0u; d < dimension; ++d)
+    {
+        // The next prime.
+        for (++prime;; ++prime)
+        {
+                auto
+            is_prime = true;
+            for (auto q = std::size_t { 2 }; q * q <= prime && is_prime; ++q)
+            {
+                is_prime = prime % q != 0;
+            }
+            if (is_prime)
+            {
+                break;
+            }
+        }
+        // The radical inverse of i + 1, in base prime.
+            auto
+        n = i + 1;
+            auto
+        f = Value (1);
+            auto
+        r = Value (0);
+        while (n > 0)
+        {
+            f /= static_cast <Value> (prime);
+            r += f * static_cast <Value> (n % prime);
+            n /= prime;
+        }
+        x[d] = r;
+    }
+    return x;
+}
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+multistart_options_t
+{
+        int
+    starts = 32;
+        unsigned
+    threads = default_thread_count ();
+    // Iterations of powell before a start is checked against the basins.
+        int
+    early_iterations = 2;
+    // Relative to the diagonal of the box: a start that gets this close to a
+    // minimum already found is dropped, and minima this close are the same.
+        Value
+    basin_radius = Value (0.05);
+        Value
+    distinct_radius = Value (1e-4);
+        powell_options_t <Value, FunctionResult>
+    powell_options = {};
+    // At the end of each start that found a minimum, the iteration being the
+    // start, once they all are.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    template <class Value, class FunctionResult>
+    struct
+multistart_minimum_t
+{
+        std::valarray <Value>
+    x;
+        FunctionResult
+    f;
+    // How many starts ended there.
+        int
+    hits;
+};
+
+    namespace
+info::data
+{
+        struct
+    multistart_iterations_t
+        : base_iterations_t
+    {
+        // iteration_count is the sum of those of powell. converged is false
+        // if no start converged.
+            int
+          pruned = 0
+        , failed = 0
+        ;
+    };
+
+        template <class Value>
+        struct
+    multistart_convergence_t
+        : multistart_iterations_t
+    {
+            std::vector <std::valarray <Value>>
+        starts;
+    };
+
+        template <class... Ts>
+        struct
+    select <MultistartTag, tag::iterations, Ts...>
+    {
+            using
+        type = multistart_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <MultistartTag, tag::convergence, Function, Value>
+    {
+            using
+        type = multistart_convergence_t <Value>;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, std::valarray <Value>>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, std::valarray <Value>>
+    auto
+multistart (
+      Function                     function
+    , std::valarray <Value> const& lower
+    , std::valarray <Value> const& upper
+    , multistart_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = InfoTag != info::tag::none;
+        constexpr static auto
+    observed = !std::is_same_v <Observer, no_observer_t>;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          MultistartTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        using
+    minimum_t = multistart_minimum_t <Value, FunctionResult>;
+        const auto
+    dimension = lower.size ();
+        using std::sqrt;
+        const auto
+    diagonal = sqrt (Value (((upper - lower) * (upper - lower)).sum ()));
+        auto
+    distance = [](std::valarray <Value> const& u, std::valarray <Value> const& v)
+    {
+            using std::sqrt;
+        return sqrt (Value (((u - v) * (u - v)).sum ()));
+    };
+        auto
+    minima = std::vector <minimum_t> {};
+        std::mutex
+    mutex;
+        auto
+    in_basin = [&](std::valarray <Value> const& x)
+    {
+            std::scoped_lock
+        lock { mutex };
+        return std::any_of (minima.begin (), minima.end (), [&](minimum_t const& m)
+        {
+            return distance (m.x, x) < options.basin_radius * diagonal;
+        });
+    };
+        auto
+    add = [&](std::valarray <Value> const& x, FunctionResult const& f)
+    {
+            std::scoped_lock
+        lock { mutex };
+            const auto
+        same = std::find_if (minima.begin (), minima.end (), [&](minimum_t const& m)
+        {
+            return distance (m.x, x) < options.distinct_radius * diagonal;
+        });
+        if (same == minima.end ())
+        {
+            minima.push_back ({ x, f, 1 });
+            return;
+        }
+        ++same->hits;
+        if (f < same->f)
+        {
+            same->x = x;
+            same->f = f;
+        }
+    };
+        const auto
+    n = static_cast <std::size_t> (std::max (options.starts, 0));
+        auto
+    iterations = std::vector <int> (n);
+        auto
+    outcome = std::vector <char> (n); // 0 failed, 1 pruned, 2 minimum
+    // Where each start ended, for the observer.
+        [[maybe_unused]]
+        auto
+    ends = std::vector <minimum_t> (observed ? n : 0);
+    if constexpr (need_info_convergence)
+    {
+        info_data.starts.resize (n);
+    }
+        auto
+    early_options = options.powell_options;
+    early_options.max_iter = std::max (options.early_iterations, 1);
+    parallel_for (n, options.threads, [&](std::size_t i)
+    {
+            auto
+        start = std::valarray <Value> (lower + halton <Value> (i, dimension) * (upper - lower));
+        if constexpr (need_info_convergence)
+        {
+            info_data.starts[i] = start;
+        }
+            auto
+        [ early, early_info ] = powell (function, std::move (start), early_options, info::iterations);
+        iterations[i] = early_info.iteration_count;
+        if (early_info.function_threw)
+        {
+            return;
+        }
+        if (!early_info.converged)
+        {
+            if (in_basin (early))
+            {
+                outcome[i] = 1;
+                return;
+            }
+                auto
+            [ p, p_info ] = powell (function, std::move (early), options.powell_options, info::iterations);
+            iterations[i] += p_info.iteration_count;
+            if (!p_info.converged)
+            {
+                return;
+            }
+            early = std::move (p);
+        }
+        // Outside powell: if it throws here, the start failed too.
+            auto
+        f = FunctionResult {};
+        try
+        {
+            f = function (early);
+        }
+        catch (...)
+        {
+            return;
+        }
+        if constexpr (observed)
+        {
+            ends[i] = { early, f, 1 };
+        }
+        add (early, f);
+        outcome[i] = 2;
+    });
+    if constexpr (observed)
+    {
+        for (auto i = 0u; i < n; ++i)
+        {
+            if (outcome[i] == 2)
+            {
+                options.observer (iteration_event_t <std::valarray <Value>, FunctionResult> {
+                    "multistart", static_cast <int> (i), step_t::local_solve, ends[i].x, ends[i].f
+                });
+            }
+        }
+    }
+    std::sort (minima.begin (), minima.end (), [](minimum_t const& u, minimum_t const& v)
+    {
+        return u.f < v.f;
+    });
+    if constexpr (need_info)
+    {
+        for (auto i = 0u; i < n; ++i)
+        {
+            info_data.iteration_count += iterations[i];
+            info_data.pruned += outcome[i] == 1;
+            info_data.failed += outcome[i] == 0;
+        }
+        info_data.converged = !minima.empty ();
+        return std::pair { minima, info_data };
+    }
+    else
+    {
+        return minima;
+    }
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,438 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <array>
+#include <limits>
+#include <optional>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Nelder-Mead simplex, with the adaptive coefficients of
+// Gao & Han, "Implementing the Nelder-Mead simplex algorithm with adaptive
+// parameters", Comput. Optim. Appl. 51 (2012).
+    struct
+NelderMeadTag
+{};
+
+    enum class
+nelder_mead_step_t
+{
+      reflection
+    , expansion
+    , outside_contraction
+    , inside_contraction
+    , shrink
+};
+
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
+    struct
+nelder_mead_options_t
+{
+        int
+    max_iter = 1000;
+    // Converged when all the function values are within tolerance of the best
+    // one...
+        FunctionResult
+    tolerance = std::sqrt (std::numeric_limits <FunctionResult>::epsilon ());
+    // ... and all the vertices within x_tolerance of the best one, in each
+    // coordinate.
+        Value
+    x_tolerance = std::sqrt (std::numeric_limits <Value>::epsilon ());
+    // The initial simplex is the initial guess plus this step along each axis.
+        Value
+    initial_step = 0.1;
+    // Dimension dependent coefficients (recommended in high dimension), or
+    // the classical 1, 2, 1/2, 1/2.
+        bool
+    adaptive = true;
+    // Evaluate the reflection, expansion and contraction points concurrently.
+    // Spends up to 3 extra evaluations per iteration, but only the latency of
+    // one. The function must then be safe to call from several threads. They
+    // run on the pool, if any, or else on one of 4 threads started for the
+    // call.
+        bool
+    concurrent = false;
+        thread_pool_t*
+    pool = nullptr;
+    // Called from the calling thread, also for the concurrent evaluations.
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+nelder_mead_no_convergence_e = defaults::no_convergence_e;
+
+    namespace
+info::data
+{
+        struct
+    nelder_mead_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+    };
+
+        template <
+              class Point
+            , class FunctionResult
+        >
+        struct
+    nelder_mead_convergence_t
+        : nelder_mead_iterations_t
+    {
+        // iteration, step taken, best function value, best point.
+            std::vector <std::tuple <int, nelder_mead_step_t, FunctionResult, Point>>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <NelderMeadTag, tag::iterations, Ts...>
+    {
+            using
+        type = nelder_mead_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Point
+        >
+        struct
+    select <NelderMeadTag, tag::convergence, Function, Point>
+    {
+            using
+        type = nelder_mead_convergence_t <
+              Point
+            , std::invoke_result_t <Function, Point>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , point Point
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Point>
+        , class FunctionResult = std::invoke_result_t <Function, Point>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Point>
+    auto
+nelder_mead (
+      Function&&   function
+    , Point const& init
+    , nelder_mead_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          NelderMeadTag
+        , InfoTag
+        , Function
+        , Point
+    > {};
+
+        const auto
+    n = init.size ();
+        const auto
+    dim = static_cast <Value> (n);
+    // Coefficients for reflection, expansion, contraction and shrink. The
+    // adaptive ones are the classical ones in 2D, and in 1D would not shrink
+    // at all (sigma = 0): the classical ones there.
+        const auto
+    adaptive = options.adaptive && n >= 2;
+        const Value
+      alpha = 1
+    , gamma = adaptive ? 1 + 2 / dim              : 2
+    , rho   = adaptive ? Value (0.75) - 1 / (2 * dim) : Value (0.5)
+    , sigma = adaptive ? 1 - 1 / dim              : Value (0.5)
+    ;
+    // All the storage is allocated once, here.
+        auto
+    x = make_point_set <Point, 1> (init);
+        auto
+    fx = std::vector <FunctionResult> (n + 1);
+        auto
+    centroid = init;
+        auto
+    xr = init;
+        auto
+    xe = init;
+        auto
+    xoc = init;
+        auto
+    xic = init;
+        FunctionResult
+      fr  {}
+    , fe  {}
+    , foc {}
+    , fic {}
+    ;
+        auto
+    own_pool = std::optional <thread_pool_t> {};
+        auto
+    pool = options.pool;
+    if (options.concurrent && !pool)
+    {
+        pool = &own_pool.emplace (4u);
+    }
+        auto
+    iteration = 0;
+        auto
+    observe = [&](Point const& p, FunctionResult const& f)
+    {
+        options.observer (iteration_event_t <Point, FunctionResult> {
+              "nelder_mead"
+            , iteration
+            , iteration == 0 ? step_t::initial : step_t::simplex
+            , p
+            , f
+        });
+    };
+        auto
+    evaluate = [&](Point const& p)
+    {
+        if constexpr (need_info)
+        {
+            ++info_data.evaluation_count;
+        }
+            const FunctionResult
+        f = function (p);
+        observe (p, f);
+        return f;
+    };
+        auto
+    best_point = [&]
+    {
+            std::size_t
+        b = 0;
+        for (auto j = 1u; j <= n; ++j)
+        {
+            if (fx[j] < fx[b]) b = j;
+        }
+        return b;
+    };
+    try
+    {
+        for (auto j = 0u; j <= n; ++j)
+        {
+            if (j > 0)
+            {
+                x[j][j - 1] += options.initial_step;
+            }
+            fx[j] = evaluate (x[j]);
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { init, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+        iteration = i + 1;
+        // Best, worst and second worst vertices.
+            std::size_t
+          b = 0
+        , w = 0
+        , s = 0
+        ;
+        for (auto j = 1u; j <= n; ++j)
+        {
+            if (fx[j] < fx[b]) b = j;
+            if (fx[j] > fx[w]) w = j;
+        }
+        s = b;
+        for (auto j = 0u; j <= n; ++j)
+        {
+            if (j != w && fx[j] > fx[s]) s = j;
+        }
+            using std::fabs;
+            bool
+        converged = true;
+        for (auto j = 0u; j <= n && converged; ++j)
+        {
+            converged = fabs (fx[j] - fx[b]) <= options.tolerance;
+            for (auto k = 0u; k < n && converged; ++k)
+            {
+                converged = fabs (x[j][k] - x[b][k]) <= options.x_tolerance;
+            }
+        }
+        if (converged)
+        {
+            if constexpr (need_info)
+            {
+                info_data.iteration_count = i;
+                return std::pair { x[b], info_data };
+            }
+            else
+            {
+                return x[b];
+            }
+        }
+        for (auto k = 0u; k < n; ++k)
+        {
+            centroid[k] = 0;
+            for (auto j = 0u; j <= n; ++j)
+            {
+                if (j != w) centroid[k] += x[j][k];
+            }
+            centroid[k] /= dim;
+        }
+        for (auto k = 0u; k < n; ++k)
+        {
+                const auto
+            d = centroid[k] - x[w][k];
+            xr[k]  = centroid[k] + alpha * d;
+            xe[k]  = centroid[k] + alpha * gamma * d;
+            xoc[k] = centroid[k] + alpha * rho * d;
+            xic[k] = centroid[k] - rho * d;
+        }
+            auto
+        step = nelder_mead_step_t::reflection;
+        try
+        {
+            if (options.concurrent)
+            {
+                    const auto
+                points = std::array { &xr, &xe, &xoc, &xic };
+                    const auto
+                values = std::array { &fr, &fe, &foc, &fic };
+                parallel_for (points.size (), *pool, [&](std::size_t j)
+                {
+                    *values[j] = function (*points[j]);
+                });
+                if constexpr (need_info)
+                {
+                    info_data.evaluation_count += static_cast <int> (points.size ());
+                }
+                for (auto j = 0u; j < points.size (); ++j)
+                {
+                    observe (*points[j], *values[j]);
+                }
+            }
+            else
+            {
+                fr = evaluate (xr);
+            }
+            if (fr < fx[b])
+            {
+                if (!options.concurrent)
+                {
+                    fe = evaluate (xe);
+                }
+                if (fe < fr)
+                {
+                    step = nelder_mead_step_t::expansion;
+                    x[w]  = xe;
+                    fx[w] = fe;
+                }
+                else
+                {
+                    x[w]  = xr;
+                    fx[w] = fr;
+                }
+            }
+            else if (fr < fx[s])
+            {
+                x[w]  = xr;
+                fx[w] = fr;
+            }
+            else if (fr < fx[w])
+            {
+                if (!options.concurrent)
+                {
+                    foc = evaluate (xoc);
+                }
+                step = foc <= fr
+                    ? nelder_mead_step_t::outside_contraction
+                    : nelder_mead_step_t::shrink
+                ;
+                if (step == nelder_mead_step_t::outside_contraction)
+                {
+                    x[w]  = xoc;
+                    fx[w] = foc;
+                }
+            }
+            else
+            {
+                if (!options.concurrent)
+                {
+                    fic = evaluate (xic);
+                }
+                step = fic < fx[w]
+                    ? nelder_mead_step_t::inside_contraction
+                    : nelder_mead_step_t::shrink
+                ;
+                if (step == nelder_mead_step_t::inside_contraction)
+                {
+                    x[w]  = xic;
+                    fx[w] = fic;
+                }
+            }
+            if (step == nelder_mead_step_t::shrink)
+            {
+                for (auto j = 0u; j <= n; ++j)
+                {
+                    if (j == b) continue;
+                    for (auto k = 0u; k < n; ++k)
+                    {
+                        x[j][k] = x[b][k] + sigma * (x[j][k] - x[b][k]);
+                    }
+                    fx[j] = evaluate (x[j]);
+                }
+            }
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.function_threw = true;
+                return std::pair { x[best_point ()], info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        if constexpr (need_info_convergence)
+        {
+                const auto
+            bb = best_point ();
+            info_data.convergence.push_back ({ i, step, fx[bb], x[bb] });
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.iteration_count = options.max_iter;
+        info_data.converged = false;
+        return std::pair { x[best_point ()], info_data };
+    }
+    else
+    {
+        throw nelder_mead_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
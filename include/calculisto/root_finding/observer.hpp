@@ -0,0 +1,241 @@
+#pragma once
+#include "root_finding.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Observers to pass to the root finders, by reference:
+//
+//     auto trace = chrome_trace_t { out };
+//     zhang (f, a, b, zhang_static_options_t <
+//           double
+//         , double
+//         , zhang_default_converged_t <double, double>
+//         , std::reference_wrapper <chrome_trace_t>
+//     > { .observer = std::ref (trace) });
+//
+// They are not synchronized: one per thread.
+
+    constexpr char const*
+step_name (step_t step)
+{
+    switch (step)
+    {
+        case step_t::initial:             return "initial";
+        case step_t::newton:              return "newton";
+        case step_t::secant:              return "secant";
+        case step_t::steffensen:          return "steffensen";
+        case step_t::bisection:           return "bisection";
+        case step_t::inverse_quadratic:   return "inverse_quadratic";
+        case step_t::quadratic:           return "quadratic";
+        case step_t::cubic:               return "cubic";
+        case step_t::projection:          return "projection";
+        case step_t::expansion:           return "expansion";
+        case step_t::sampling:            return "sampling";
+        case step_t::golden_section:      return "golden_section";
+        case step_t::line_search:         return "line_search";
+        case step_t::simplex:             return "simplex";
+        case step_t::levenberg_marquardt: return "levenberg_marquardt";
+        case step_t::fixed_point:         return "fixed_point";
+        case step_t::aberth:              return "aberth";
+        case step_t::local_solve:         return "local_solve";
+        case step_t::evolution:           return "evolution";
+    }
+    return "unknown";
+}
+
+    namespace
+observer_detail
+{
+        template <class T>
+        double
+    to_double (T const& x)
+    {
+        if constexpr (std::is_convertible_v <T, double>)
+        {
+            return static_cast <double> (x);
+        }
+        else
+        {
+            return std::numeric_limits <double>::quiet_NaN ();
+        }
+    }
+} // namespace observer_detail
+
+// The Chrome trace event format (JSON array format), for chrome://tracing or
+// Perfetto: an instant event per evaluation, named after the solver, with the
+// iteration, the step, x and f as arguments.
+    class
+chrome_trace_t
+{
+        std::ostream&
+    out;
+        std::chrono::steady_clock::time_point
+    start = std::chrono::steady_clock::now ();
+        bool
+    first = true;
+
+        void
+    number (double x)
+    {
+            using std::isfinite;
+        if (isfinite (x))
+        {
+            out << x;
+        }
+        else
+        {
+            out << "null";
+        }
+    }
+
+    public:
+    explicit
+    chrome_trace_t (std::ostream& out)
+        : out { out }
+    {
+        out.precision (17);
+        out << "[";
+    }
+
+    chrome_trace_t (chrome_trace_t const&) = delete;
+
+        chrome_trace_t&
+    operator = (chrome_trace_t const&) = delete;
+
+    ~chrome_trace_t ()
+    {
+        out << "\n]\n";
+    }
+
+        template <class Value, class FunctionResult>
+        void
+    operator () (iteration_event_t <Value, FunctionResult> const& event)
+    {
+            const auto
+        ts = std::chrono::duration <double, std::micro> (std::chrono::steady_clock::now () - start).count ();
+        out << (first ? "\n" : ",\n")
+            << R"({"name":")" << event.solver
+            << R"(","cat":"root_finding","ph":"i","s":"t","pid":1,"tid":)"
+            << std::hash <std::thread::id> {} (std::this_thread::get_id ())
+            << R"(,"ts":)" << ts
+            << R"(,"args":{"iteration":)" << event.iteration
+            << R"(,"step":")" << step_name (event.step)
+            << R"(","x":)"
+        ;
+        number (observer_detail::to_double (event.x));
+        out << R"(,"f":)";
+        number (observer_detail::to_double (event.f));
+        out << "}}";
+        first = false;
+    }
+};
+
+// A binary log of the events: a magic number, then fixed size records, in the
+// native byte order. x and f are converted to double (NaN if they can't be).
+    struct
+event_record_t
+{
+    // Truncated, and null terminated if shorter.
+        char
+    solver[16];
+    // Nanoseconds since the log was created.
+        std::uint64_t
+    time;
+        std::int32_t
+    iteration;
+        std::int32_t
+    step;
+        double
+      x
+    , f
+    ;
+};
+
+// Not an event log.
+    struct
+event_log_bad_file_e
+{};
+
+    namespace
+observer_detail
+{
+        constexpr char
+    magic[8] = { 'C', 'R', 'F', 'E', 'V', 'T', '0', '1' };
+} // namespace observer_detail
+
+    class
+binary_event_log_t
+{
+        std::ostream&
+    out;
+        std::chrono::steady_clock::time_point
+    start = std::chrono::steady_clock::now ();
+
+    public:
+    explicit
+    binary_event_log_t (std::ostream& out)
+        : out { out }
+    {
+        out.write (observer_detail::magic, sizeof observer_detail::magic);
+    }
+
+    binary_event_log_t (binary_event_log_t const&) = delete;
+
+        binary_event_log_t&
+    operator = (binary_event_log_t const&) = delete;
+
+        template <class Value, class FunctionResult>
+        void
+    operator () (iteration_event_t <Value, FunctionResult> const& event)
+    {
+            auto
+        record = event_record_t {};
+        std::strncpy (record.solver, event.solver, sizeof record.solver);
+        record.time = static_cast <std::uint64_t> (
+            std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start).count ()
+        );
+        record.iteration = event.iteration;
+        record.step = static_cast <std::int32_t> (event.step);
+        record.x = observer_detail::to_double (event.x);
+        record.f = observer_detail::to_double (event.f);
+        out.write (reinterpret_cast <char const*> (&record), sizeof record);
+    }
+};
+
+    inline std::vector <event_record_t>
+read_event_log (std::istream& in)
+{
+        char
+    magic[sizeof observer_detail::magic];
+    if (
+           !in.read (magic, sizeof magic)
+        || std::memcmp (magic, observer_detail::magic, sizeof magic) != 0
+    ){
+        throw event_log_bad_file_e {};
+    }
+        auto
+    records = std::vector <event_record_t> {};
+        auto
+    record = event_record_t {};
+    while (in.read (reinterpret_cast <char*> (&record), sizeof record))
+    {
+        records.push_back (record);
+    }
+    if (in.gcount () != 0)
+    {
+        throw event_log_bad_file_e {};
+    }
+    return records;
+}
+} // namespace calculisto::root_finding
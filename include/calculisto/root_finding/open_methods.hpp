@@ -0,0 +1,393 @@
+#pragma once
+#include "root_finding.hpp"
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+// Alternatives to newton when there is no derivative (and no bracket): the
+// same convergence predicate, the same exceptions and the same info, the
+// "derivative" being the slope they use instead.
+
+// What options they can take
+    template <
+          class Value
+        , class FunctionResult
+        , class Observer = no_observer_t
+    >
+    struct
+open_method_options_t
+{
+        int
+    max_iter = 100;
+        std::function <bool (
+          Value const&
+        , Value const&
+        , FunctionResult const&
+    )>
+    converged = &newton_default_converged <Value, FunctionResult>;
+    // Secant only: the second point is initial_guess + initial_step * max (1,
+    // |initial_guess|).
+        Value
+    initial_step = std::sqrt (std::numeric_limits <Value>::epsilon ());
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+//------------------------------------------------------------------------------
+// Secant method: one evaluation per iteration, superlinear (order 1.618)
+// convergence.
+    struct
+SecantTag
+{};
+
+    template <class Value, class FunctionResult, class... Ts>
+    using
+secant_options_t = open_method_options_t <Value, FunctionResult, Ts...>;
+
+    using
+secant_no_convergence_e = newton_no_convergence_e;
+
+// Two equal function values in a row.
+    using
+secant_zero_slope_e = newton_zero_derivative_e;
+
+    namespace
+info::data
+{
+        template <class... Ts>
+        struct
+    select <SecantTag, tag::iterations, Ts...>
+    {
+            using
+        type = newton_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <SecantTag, tag::convergence, Function, Value>
+    {
+            using
+        type = convergence_newton_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+secant (
+      Function&&       function
+    , Value const&     initial_guess
+    , secant_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          SecantTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        using std::fabs;
+        Value
+    past = initial_guess;
+        Value
+    current = initial_guess
+        + options.initial_step * std::max (Value (1), Value (fabs (initial_guess)));
+        auto
+    f_past = FunctionResult {};
+    try
+    {
+        f_past = std::forward <Function> (function) (past);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { past, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    options.observer (iteration_event_t <Value, FunctionResult> { "secant", 0, step_t::initial, past, f_past });
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+            auto
+        f = FunctionResult {};
+        try
+        {
+            f = std::forward <Function> (function) (current);
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.function_threw = true;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "secant"
+            , i
+            , i == 0 ? step_t::initial : step_t::secant
+            , current
+            , f
+        });
+            const auto
+        slope = (f - f_past) / (current - past);
+        if (f != 0 && slope == 0)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.zero_derivative = true;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw secant_zero_slope_e {};
+            }
+        }
+        past = current;
+        f_past = f;
+        if (f != 0)
+        {
+            current -= f / slope;
+        }
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({current, f, slope});
+        }
+        if (options.converged (current, past, f))
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            if constexpr (need_info)
+            {
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                return current;
+            }
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.converged = false;
+        return std::pair { current, info_data };
+    }
+    else
+    {
+        throw secant_no_convergence_e {};
+    }
+}
+
+//------------------------------------------------------------------------------
+// Steffensen method: Newton with the slope (f (x + f (x)) - f (x)) / f (x), i.e.
+// the Aitken acceleration of the fixed point iteration x + f (x). Two
+// evaluations per iteration, quadratic convergence, but f must be of the order
+// of x - root near the root for the first iterations to behave.
+    struct
+SteffensenTag
+{};
+
+    template <class Value, class FunctionResult, class... Ts>
+    using
+steffensen_options_t = open_method_options_t <Value, FunctionResult, Ts...>;
+
+    using
+steffensen_no_convergence_e = newton_no_convergence_e;
+
+    using
+steffensen_zero_slope_e = newton_zero_derivative_e;
+
+    namespace
+info::data
+{
+        template <class... Ts>
+        struct
+    select <SteffensenTag, tag::iterations, Ts...>
+    {
+            using
+        type = newton_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <SteffensenTag, tag::convergence, Function, Value>
+    {
+            using
+        type = convergence_newton_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+steffensen (
+      Function&&       function
+    , Value const&     initial_guess
+    , steffensen_options_t <Value, FunctionResult, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          SteffensenTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        Value
+    past;
+        Value
+    current = initial_guess;
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+            auto
+          f  = FunctionResult {}
+        , fs = FunctionResult {}
+        ;
+        try
+        {
+            f = std::forward <Function> (function) (current);
+            if (f != 0)
+            {
+                fs = std::forward <Function> (function) (current + f);
+            }
+        }
+        catch (...)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.function_threw = true;
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                throw;
+            }
+        }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "steffensen"
+            , i
+            , i == 0 ? step_t::initial : step_t::steffensen
+            , current
+            , f
+        });
+        if (f != 0)
+        {
+            options.observer (iteration_event_t <Value, FunctionResult> { "steffensen", i, step_t::steffensen, current + f, fs });
+        }
+            auto
+        slope = FunctionResult {};
+        past = current;
+        if (f != 0)
+        {
+            slope = (fs - f) / f;
+            if (slope == 0)
+            {
+                if constexpr (need_info)
+                {
+                    info_data.converged = false;
+                    info_data.zero_derivative = true;
+                    return std::pair { current, info_data };
+                }
+                else
+                {
+                    throw steffensen_zero_slope_e {};
+                }
+            }
+            current -= f / slope;
+        }
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({current, f, slope});
+        }
+        if (options.converged (current, past, f))
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            if constexpr (need_info)
+            {
+                return std::pair { current, info_data };
+            }
+            else
+            {
+                return current;
+            }
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.converged = false;
+        return std::pair { current, info_data };
+    }
+    else
+    {
+        throw steffensen_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
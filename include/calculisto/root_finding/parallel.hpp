@@ -0,0 +1,248 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Threads, for the parallel modes of the algorithms.
+
+// By default, as many threads as cores.
+    inline unsigned
+default_thread_count ()
+{
+    return std::max (std::thread::hardware_concurrency (), 1u);
+}
+
+    namespace
+parallel_detail
+{
+    // Calls f (i) for i in [0, n), handing the indices out one at a time to
+    // the threads that call it. Once an exception is thrown, no new index is
+    // handed out, and the first exception is kept.
+        template <class F>
+        struct
+    job_t
+    {
+            std::size_t
+        n;
+            F&
+        f;
+            std::atomic <std::size_t>
+        next = 0;
+            std::atomic <bool>
+        failed = false;
+            std::exception_ptr
+        error;
+            std::mutex
+        error_mutex;
+
+        job_t (std::size_t n, F& f)
+            : n { n }
+            , f { f }
+        {}
+
+            void
+        operator () ()
+        {
+            for (;;)
+            {
+                    const auto
+                i = next++;
+                if (i >= n || failed)
+                {
+                    return;
+                }
+                try
+                {
+                    f (i);
+                }
+                catch (...)
+                {
+                        std::scoped_lock
+                    lock { error_mutex };
+                    if (!error)
+                    {
+                        error = std::current_exception ();
+                    }
+                    failed = true;
+                }
+            }
+        }
+
+            void
+        rethrow () const
+        {
+            if (error)
+            {
+                std::rethrow_exception (error);
+            }
+        }
+    };
+} // namespace parallel_detail
+
+// Calls f (i) for i in [0, n), on up to `threads` threads, the calling one
+// included, handing the indices out one at a time. Once an exception is thrown,
+// no new index is handed out, and the first exception is rethrown when all the
+// threads are done. The threads are started for the call, and joined before it
+// returns.
+    template <class F>
+    void
+parallel_for (std::size_t n, unsigned threads, F&& f)
+{
+    threads = static_cast <unsigned> (std::clamp <std::size_t> (threads, 1, std::max <std::size_t> (n, 1)));
+        auto
+    job = parallel_detail::job_t <F> { n, f };
+    {
+            std::vector <std::jthread>
+        pool;
+        pool.reserve (threads - 1);
+        for (auto t = 1u; t < threads; ++t)
+        {
+            pool.emplace_back (std::ref (job));
+        }
+        job ();
+    }
+    job.rethrow ();
+}
+
+//------------------------------------------------------------------------------
+// Threads kept alive between the calls to parallel_for, for algorithms that
+// call it many times on few points each (k_section, nelder_mead): starting and
+// joining the threads at each call may then cost more than the evaluations.
+// The workers wait on a condition variable between the calls. One call at a
+// time: the concurrent ones wait for each other.
+    class
+thread_pool_t
+{
+        std::mutex
+      call_mutex
+    , mutex
+    ;
+        std::condition_variable
+      wake
+    , done
+    ;
+    // The job of the current call, its number, and the workers still at it.
+        std::function <void ()>
+    job;
+        std::size_t
+    generation = 0;
+        std::size_t
+    running = 0;
+        bool
+    stopping = false;
+    // Last, so that the workers are joined before the rest is destroyed.
+        std::vector <std::jthread>
+    workers;
+
+        void
+    work ()
+    {
+            auto
+        seen = std::size_t { 0 };
+        for (;;)
+        {
+            {
+                    std::unique_lock
+                lock { mutex };
+                wake.wait (lock, [&]{ return stopping || generation != seen; });
+                if (stopping)
+                {
+                    return;
+                }
+                seen = generation;
+            }
+            job ();
+            {
+                    std::scoped_lock
+                lock { mutex };
+                if (--running == 0)
+                {
+                    done.notify_one ();
+                }
+            }
+        }
+    }
+
+    public:
+    // threads, the calling one included: threads - 1 workers.
+    explicit
+    thread_pool_t (unsigned threads = default_thread_count ())
+    {
+        workers.reserve (std::max (threads, 1u) - 1);
+        for (auto t = 1u; t < threads; ++t)
+        {
+            workers.emplace_back ([this]{ work (); });
+        }
+    }
+
+    ~thread_pool_t ()
+    {
+        {
+                std::scoped_lock
+            lock { mutex };
+            stopping = true;
+        }
+        wake.notify_all ();
+    }
+
+    thread_pool_t (thread_pool_t const&) = delete;
+
+        thread_pool_t&
+    operator = (thread_pool_t const&) = delete;
+
+    // The calling thread included.
+        unsigned
+    size () const
+    {
+        return static_cast <unsigned> (workers.size ()) + 1;
+    }
+
+    // As the free parallel_for, on the workers and the calling thread.
+        template <class F>
+        void
+    parallel_for (std::size_t n, F&& f)
+    {
+            std::scoped_lock
+        call_lock { call_mutex };
+            auto
+        current = parallel_detail::job_t <F> { n, f };
+        if (!workers.empty () && n > 1)
+        {
+            {
+                    std::scoped_lock
+                lock { mutex };
+                job = std::ref (current);
+                running = workers.size ();
+                ++generation;
+            }
+            wake.notify_all ();
+            current ();
+                std::unique_lock
+            lock { mutex };
+            done.wait (lock, [&]{ return running == 0; });
+        }
+        else
+        {
+            current ();
+        }
+        current.rethrow ();
+    }
+};
+
+// On the threads of the pool.
+    template <class F>
+    void
+parallel_for (std::size_t n, thread_pool_t& pool, F&& f)
+{
+    pool.parallel_for (n, std::forward <F> (f));
+}
+} // namespace calculisto::root_finding
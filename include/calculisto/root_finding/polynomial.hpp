@@ -0,0 +1,726 @@
+#pragma once
+#include "root_finding.hpp"
+#include <complex>
+#include <limits>
+#include <algorithm>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// All the roots of a polynomial c[0] + c[1] x + ... + c[n] x^n, at once.
+//
+// Aberth-Ehrlich simultaneous iteration (Bini, "Numerical computation of
+// polynomial zeros by means of Aberth's method", Numer. Algorithms 13, 1996),
+// or, for degrees up to 4, closed forms, polished by Newton's method.
+//
+// With a std::array of coefficients, the roots are in a std::array too: no
+// allocation.
+    struct
+PolynomialTag
+{};
+
+    template <class Value, class Observer = no_observer_t>
+    struct
+polynomial_options_t
+{
+        int
+    max_iter = 100;
+    // A root has converged when the Aberth correction, relative to the root,
+    // is below tolerance, or when the polynomial at the root is below its
+    // rounding error.
+        Value
+    tolerance = 4 * std::numeric_limits <Value>::epsilon ();
+    // A root is real if its imaginary part, relative to its modulus, is below.
+        Value
+    imaginary_tolerance = std::sqrt (std::numeric_limits <Value>::epsilon ());
+    // Use the closed forms for degrees up to 4.
+        bool
+    closed_form = true;
+    // At each evaluation of the polynomial at a root by the Aberth iterations
+    // (not for the closed forms, nor for the batches).
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    using
+polynomial_no_convergence_e = defaults::no_convergence_e;
+
+    struct
+polynomial_zero_leading_coefficient_e
+{};
+
+    namespace
+info::data
+{
+        struct
+    polynomial_iterations_t
+        : base_iterations_t
+    {
+            bool
+        zero_leading_coefficient = false;
+    };
+
+        template <class Roots>
+        struct
+    polynomial_convergence_t
+        : polynomial_iterations_t
+    {
+        // The roots, after each iteration.
+            std::vector <Roots>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <PolynomialTag, tag::iterations, Ts...>
+    {
+            using
+        type = polynomial_iterations_t;
+    };
+
+        template <class Roots>
+        struct
+    select <PolynomialTag, tag::convergence, Roots>
+    {
+            using
+        type = polynomial_convergence_t <Roots>;
+    };
+} // namespace info::data
+
+// Where the roots go: a std::array for a std::array of coefficients, a
+// std::vector otherwise.
+    template <class Coefficients>
+    using
+polynomial_roots_t = std::conditional_t <
+      fixed_size_v <Coefficients> != 0
+    , std::array <std::complex <point_value_t <Coefficients>>, fixed_size_v <Coefficients> - 1>
+    , std::vector <std::complex <point_value_t <Coefficients>>>
+>;
+
+// A fixed capacity container for the real roots.
+    template <class Value, std::size_t N>
+    struct
+real_roots_t
+{
+        std::array <Value, N>
+    values = {};
+        std::size_t
+    count = 0;
+
+        void
+    push_back (Value v)
+    {
+        values[count++] = v;
+    }
+        std::size_t
+    size () const
+    {
+        return count;
+    }
+        Value const&
+    operator [] (std::size_t i) const
+    {
+        return values[i];
+    }
+        auto
+    begin () const
+    {
+        return values.begin ();
+    }
+        auto
+    end () const
+    {
+        return values.begin () + count;
+    }
+};
+
+    template <class Coefficients>
+    using
+polynomial_real_roots_t = std::conditional_t <
+      fixed_size_v <Coefficients> != 0
+    , real_roots_t <point_value_t <Coefficients>, fixed_size_v <Coefficients> - 1>
+    , std::vector <point_value_t <Coefficients>>
+>;
+
+// p (z), p' (z), and a bound on the rounding error of the evaluation of p (z).
+    template <point Coefficients, class Complex>
+    auto
+horner (Coefficients const& c, Complex const& z)
+{
+        using std::abs;
+        const auto
+    n = c.size () - 1;
+        auto
+    p = Complex (c[n]);
+        auto
+    dp = Complex {};
+        auto
+    e = abs (c[n]);
+        const auto
+    az = abs (z);
+    for (auto k = n; k-- > 0;)
+    {
+        dp = dp * z + p;
+        p  = p * z + c[k];
+        e  = e * az + abs (c[k]);
+    }
+    return std::tuple { p, dp, e };
+}
+
+// Closed forms. The roots of the degree n = c.size () - 1 <= 4 polynomial are
+// written in z[0], ..., z[n - 1].
+    template <point Coefficients, class Roots>
+    void
+polynomial_closed_form_roots (Coefficients const& c, Roots& z)
+{
+        using
+    value_t = point_value_t <Coefficients>;
+        using
+    complex_t = std::complex <value_t>;
+        const auto
+    n = c.size () - 1;
+    // a x^2 + b x + c, stable.
+        auto
+    quadratic = [](complex_t a, complex_t b, complex_t c, complex_t& z0, complex_t& z1)
+    {
+            const auto
+        d = std::sqrt (b * b - value_t (4) * a * c);
+            const auto
+        q = std::real (std::conj (b) * d) >= 0
+            ? value_t (-0.5) * (b + d)
+            : value_t (-0.5) * (b - d)
+        ;
+        if (q == complex_t {})
+        {
+            z0 = z1 = complex_t {};
+            return;
+        }
+        z0 = q / a;
+        z1 = c / q;
+    };
+    // x^3 + a x^2 + b x + c, Cardano.
+        auto
+    cubic = [](complex_t a, complex_t b, complex_t c, complex_t& z0, complex_t& z1, complex_t& z2)
+    {
+            const auto
+        p = b - a * a / value_t (3);
+            const auto
+        q = value_t (2) * a * a * a / value_t (27) - a * b / value_t (3) + c;
+            const auto
+        d = std::sqrt (q * q / value_t (4) + p * p * p / value_t (27));
+            const auto
+        u = std::abs (-q / value_t (2) + d) >= std::abs (-q / value_t (2) - d)
+            ? -q / value_t (2) + d
+            : -q / value_t (2) - d
+        ;
+            const auto
+        C = std::pow (u, value_t (1) / value_t (3));
+            const auto
+        omega = complex_t (value_t (-0.5), std::sqrt (value_t (3)) / value_t (2));
+            const auto
+        shift = a / value_t (3);
+        if (C == complex_t {})
+        {
+            z0 = z1 = z2 = -shift;
+            return;
+        }
+        z0 = C - p / (value_t (3) * C) - shift;
+        z1 = C * omega - p / (value_t (3) * C * omega) - shift;
+        z2 = C * omega * omega - p / (value_t (3) * C * omega * omega) - shift;
+    };
+    switch (n)
+    {
+    case 1:
+        z[0] = complex_t (-c[0] / c[1]);
+        break;
+    case 2:
+        quadratic (c[2], c[1], c[0], z[0], z[1]);
+        break;
+    case 3:
+        cubic (c[2] / c[3], c[1] / c[3], c[0] / c[3], z[0], z[1], z[2]);
+        break;
+    case 4:
+    {
+        // Ferrari: y^4 + p y^2 + q y + r, with x = y - a / 4.
+            const auto
+          a = complex_t (c[3] / c[4])
+        , b = complex_t (c[2] / c[4])
+        , cc = complex_t (c[1] / c[4])
+        , d = complex_t (c[0] / c[4])
+        ;
+            const auto
+        p = b - value_t (3) * a * a / value_t (8);
+            const auto
+        q = a * a * a / value_t (8) - a * b / value_t (2) + cc;
+            const auto
+        r = - value_t (3) * a * a * a * a / value_t (256) + a * a * b / value_t (16) - a * cc / value_t (4) + d;
+            const auto
+        shift = a / value_t (4);
+        // Resolvent cubic 8 m^3 + 8 p m^2 + (2 p^2 - 8 r) m - q^2.
+            complex_t
+        m[3];
+        cubic (p, p * p / value_t (4) - r, - q * q / value_t (8), m[0], m[1], m[2]);
+            const auto
+        mm = *std::max_element (m, m + 3, [](auto x, auto y){ return std::abs (x) < std::abs (y); });
+        if (mm == complex_t {})
+        {
+            // Then q = 0: biquadratic.
+                complex_t
+            w0, w1;
+            quadratic (complex_t (1), p, r, w0, w1);
+            z[0] =  std::sqrt (w0) - shift;
+            z[1] = -std::sqrt (w0) - shift;
+            z[2] =  std::sqrt (w1) - shift;
+            z[3] = -std::sqrt (w1) - shift;
+            break;
+        }
+            const auto
+        s = std::sqrt (value_t (2) * mm);
+        quadratic (complex_t (1), -s, p / value_t (2) + mm + q / (value_t (2) * s), z[0], z[1]);
+        quadratic (complex_t (1),  s, p / value_t (2) + mm - q / (value_t (2) * s), z[2], z[3]);
+        for (auto k = 0; k < 4; ++k)
+        {
+            z[k] -= shift;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    // Polish.
+    for (auto k = 0u; k < n; ++k)
+    {
+        for (auto j = 0; j < 2; ++j)
+        {
+                const auto
+            [ p, dp, e ] = horner (c, z[k]);
+            if (dp == complex_t {} || std::abs (p) <= std::numeric_limits <value_t>::epsilon () * e)
+            {
+                break;
+            }
+                const auto
+            z_new = z[k] - p / dp;
+            if (!(std::abs (std::get <0> (horner (c, z_new))) < std::abs (p)))
+            {
+                break;
+            }
+            z[k] = z_new;
+        }
+    }
+}
+
+    template <
+          point Coefficients
+        , info_tag_t InfoTag = info::tag::none
+        , class Value = point_value_t <Coefficients>
+        , class Observer = no_observer_t
+    >
+    auto
+polynomial_roots (
+      Coefficients const& c
+    , polynomial_options_t <Value, Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        using
+    roots_t = polynomial_roots_t <Coefficients>;
+        using
+    complex_t = std::complex <Value>;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          PolynomialTag
+        , InfoTag
+        , roots_t
+    > {};
+
+    // Fewer than two coefficients: nothing to solve, as with a zero leading
+    // coefficient.
+        const auto
+    n = c.size () < 2 ? std::size_t { 0 } : c.size () - 1;
+        auto
+    z = roots_t {};
+    if constexpr (fixed_size_v <Coefficients> == 0)
+    {
+        z.resize (n);
+    }
+        auto
+    return_ = [&](bool converged)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { z, info_data };
+        }
+        else
+        {
+            return z;
+        }
+    };
+    if (n == 0 || c[n] == 0)
+    {
+        if constexpr (need_info)
+        {
+            info_data.zero_leading_coefficient = true;
+            return return_ (false);
+        }
+        else
+        {
+            throw polynomial_zero_leading_coefficient_e {};
+        }
+    }
+    if (options.closed_form && n <= 4)
+    {
+        polynomial_closed_form_roots (c, z);
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = 0;
+        }
+        return return_ (true);
+    }
+    // Initial guesses on a circle, with an offset to break symmetries.
+        using std::abs;
+        using std::pow;
+        auto
+    radius = pow (abs (c[0] / c[n]), Value (1) / n);
+    if (!(radius > 0))
+    {
+        radius = 1;
+    }
+    for (auto k = 0u; k < n; ++k)
+    {
+        z[k] = std::polar (radius, Value (0.4) + 2 * std::numbers::pi_v <Value> * k / n);
+    }
+    for (int i = 0; i < options.max_iter; ++i)
+    {
+            bool
+        converged = true;
+        for (auto k = 0u; k < n; ++k)
+        {
+                const auto
+            [ p, dp, e ] = horner (c, z[k]);
+            options.observer (iteration_event_t <complex_t, complex_t> {
+                  "polynomial_roots"
+                , i
+                , i == 0 ? step_t::initial : step_t::aberth
+                , z[k]
+                , p
+            });
+            if (abs (p) <= options.tolerance * e)
+            {
+                continue;
+            }
+                const auto
+            ratio = p / dp;
+                auto
+            sum = complex_t {};
+            for (auto j = 0u; j < n; ++j)
+            {
+                if (j != k)
+                {
+                    sum += Value (1) / (z[k] - z[j]);
+                }
+            }
+                const auto
+            w = ratio / (Value (1) - ratio * sum);
+            if (!std::isfinite (abs (w)))
+            {
+                converged = false;
+                continue;
+            }
+            z[k] -= w;
+            converged = converged && abs (w) <= options.tolerance * abs (z[k]);
+        }
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back (z);
+        }
+        if (converged)
+        {
+            if constexpr (need_info_iterations)
+            {
+                info_data.iteration_count = i;
+            }
+            return return_ (true);
+        }
+    }
+    if constexpr (need_info)
+    {
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = options.max_iter;
+        }
+        return return_ (false);
+    }
+    else
+    {
+        throw polynomial_no_convergence_e {};
+    }
+}
+
+// The real roots, in increasing order.
+    template <
+          point Coefficients
+        , class Value = point_value_t <Coefficients>
+        , class Observer = no_observer_t
+    >
+    auto
+polynomial_real_roots (
+      Coefficients const& c
+    , polynomial_options_t <Value, Observer> const& options = {}
+){
+        auto
+    r = polynomial_real_roots_t <Coefficients> {};
+    for (auto const& z: polynomial_roots (c, options))
+    {
+            using std::abs;
+        if (abs (z.imag ()) <= options.imaginary_tolerance * std::max (Value (1), abs (z)))
+        {
+            r.push_back (z.real ());
+        }
+    }
+    if constexpr (fixed_size_v <Coefficients> != 0)
+    {
+        std::sort (r.values.begin (), r.values.begin () + r.count);
+    }
+    else
+    {
+        std::sort (r.begin (), r.end ());
+    }
+    return r;
+}
+
+//------------------------------------------------------------------------------
+// Many polynomials of the same degree N, stored by structure of arrays: the
+// coefficient k of the polynomial i is coefficients[k][i], and the real and
+// imaginary parts of its root k are real[k][i] and imag[k][i]. The Aberth
+// iterations then run over contiguous arrays, the innermost loops being over
+// the polynomials, which the compiler can vectorize.
+    template <class Value, std::size_t N>
+    struct
+polynomial_batch_t
+{
+        std::array <std::vector <Value>, N + 1>
+    coefficients;
+        std::array <std::vector <Value>, N>
+      real
+    , imag
+    ;
+
+    polynomial_batch_t (std::size_t size)
+    {
+        for (auto& c: coefficients) c.resize (size);
+        for (auto& c: real)         c.resize (size);
+        for (auto& c: imag)         c.resize (size);
+    }
+        std::size_t
+    size () const
+    {
+        return coefficients[0].size ();
+    }
+};
+
+// Solves all the polynomials of the batch, writing their roots in the batch.
+// With info, returns the info (the number of iterations is the one of the
+// slowest polynomial) instead of throwing.
+    template <
+          class Value
+        , std::size_t N
+        , info_tag_t InfoTag = info::tag::none
+    >
+    requires (N > 0)
+    auto
+polynomial_roots (
+      polynomial_batch_t <Value, N>& batch
+    , polynomial_options_t <Value> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info = InfoTag == info::tag::iterations;
+    static_assert (InfoTag != info::tag::convergence, "Only info::iterations for batches.");
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          PolynomialTag
+        , InfoTag
+    > {};
+
+        const auto
+    size = batch.size ();
+        auto const&
+    c = batch.coefficients;
+        auto&
+    re = batch.real;
+        auto&
+    im = batch.imag;
+    // Scratch, per polynomial.
+        auto
+    scratch = std::array <std::vector <Value>, 7> {};
+    for (auto& s: scratch) s.resize (size);
+        auto&
+      [ pr, pi, dpr, dpi, sr, si, e ]
+    = scratch;
+
+    for (auto i = 0u; i < size; ++i)
+    {
+        if (c[N][i] == 0)
+        {
+            if constexpr (need_info)
+            {
+                info_data.converged = false;
+                info_data.zero_leading_coefficient = true;
+                return info_data;
+            }
+            else
+            {
+                throw polynomial_zero_leading_coefficient_e {};
+            }
+        }
+    }
+    for (auto k = 0u; k < N; ++k)
+    {
+            const auto
+        angle = Value (0.4) + 2 * std::numbers::pi_v <Value> * k / N;
+            const auto
+          ca = std::cos (angle)
+        , sa = std::sin (angle)
+        ;
+        for (auto i = 0u; i < size; ++i)
+        {
+                using std::abs;
+                using std::pow;
+                auto
+            radius = pow (abs (c[0][i] / c[N][i]), Value (1) / N);
+            radius = radius > 0 ? radius : Value (1);
+            re[k][i] = radius * ca;
+            im[k][i] = radius * sa;
+        }
+    }
+    for (int it = 0; it < options.max_iter; ++it)
+    {
+            bool
+        converged = true;
+        for (auto k = 0u; k < N; ++k)
+        {
+            // Horner, for p, p' and the rounding error bound.
+            for (auto i = 0u; i < size; ++i)
+            {
+                pr[i]  = c[N][i];
+                pi[i]  = 0;
+                dpr[i] = 0;
+                dpi[i] = 0;
+                e[i]   = std::abs (c[N][i]);
+            }
+            for (auto d = N; d-- > 0;)
+            {
+                for (auto i = 0u; i < size; ++i)
+                {
+                        const auto
+                      zr = re[k][i]
+                    , zi = im[k][i]
+                    ;
+                        const auto
+                    t = dpr[i] * zr - dpi[i] * zi + pr[i];
+                    dpi[i] = dpr[i] * zi + dpi[i] * zr + pi[i];
+                    dpr[i] = t;
+                        const auto
+                    u = pr[i] * zr - pi[i] * zi + c[d][i];
+                    pi[i] = pr[i] * zi + pi[i] * zr;
+                    pr[i] = u;
+                    e[i] = e[i] * std::sqrt (zr * zr + zi * zi) + std::abs (c[d][i]);
+                }
+            }
+            // Sum of 1 / (z_k - z_j), j != k.
+            for (auto i = 0u; i < size; ++i)
+            {
+                sr[i] = 0;
+                si[i] = 0;
+            }
+            for (auto j = 0u; j < N; ++j)
+            {
+                if (j == k) continue;
+                for (auto i = 0u; i < size; ++i)
+                {
+                        const auto
+                      dr = re[k][i] - re[j][i]
+                    , di = im[k][i] - im[j][i]
+                    ;
+                        const auto
+                    m2 = dr * dr + di * di;
+                    sr[i] +=  dr / m2;
+                    si[i] += -di / m2;
+                }
+            }
+            // Correction w = (p / p') / (1 - (p / p') sum).
+                auto
+            not_converged = 0;
+            for (auto i = 0u; i < size; ++i)
+            {
+                    const auto
+                dm2 = dpr[i] * dpr[i] + dpi[i] * dpi[i];
+                    const auto
+                rr = (pr[i] * dpr[i] + pi[i] * dpi[i]) / dm2;
+                    const auto
+                ri = (pi[i] * dpr[i] - pr[i] * dpi[i]) / dm2;
+                    const auto
+                qr = 1 - (rr * sr[i] - ri * si[i]);
+                    const auto
+                qi = -(rr * si[i] + ri * sr[i]);
+                    const auto
+                qm2 = qr * qr + qi * qi;
+                    const auto
+                wr = (rr * qr + ri * qi) / qm2;
+                    const auto
+                wi = (ri * qr - rr * qi) / qm2;
+                    const auto
+                at_root = std::sqrt (pr[i] * pr[i] + pi[i] * pi[i]) <= options.tolerance * e[i];
+                    const auto
+                finite = std::isfinite (wr) && std::isfinite (wi);
+                    const auto
+                step = !at_root && finite;
+                re[k][i] -= step ? wr : Value (0);
+                im[k][i] -= step ? wi : Value (0);
+                    const auto
+                small = wr * wr + wi * wi
+                    <= options.tolerance * options.tolerance * (re[k][i] * re[k][i] + im[k][i] * im[k][i]);
+                not_converged += !(at_root || (finite && small));
+            }
+            converged = converged && not_converged == 0;
+        }
+        if (converged)
+        {
+            if constexpr (need_info)
+            {
+                info_data.iteration_count = it;
+                return info_data;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+    if constexpr (need_info)
+    {
+        info_data.iteration_count = options.max_iter;
+        info_data.converged = false;
+        return info_data;
+    }
+    else
+    {
+        throw polynomial_no_convergence_e {};
+    }
+}
+} // namespace calculisto::root_finding
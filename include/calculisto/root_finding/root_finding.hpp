@@ -10,6 +10,14 @@
 #include <ranges>
 #include <valarray>
 #include <functional>
+#include <concepts>
+#include <span>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
 
     namespace 
 calculisto::root_finding
@@ -79,7 +87,7 @@ info
             : base_t
         {
                 int
-            iteration_count;
+            iteration_count = 0;
         };
 
         // Select the right data type
@@ -102,6 +110,196 @@ info
     } // namespace data
 
 } // namespace info
+
+// fabs, also in constant expressions.
+    template <class T>
+    constexpr auto
+constexpr_fabs (T const& x)
+{
+    if (std::is_constant_evaluated ())
+    {
+        return x < 0 ? T (-x) : x;
+    }
+        using std::fabs;
+    return T (fabs (x));
+}
+
+//------------------------------------------------------------------------------
+// Points, for the multidimensional algorithms: any indexable container with a
+// size (), e.g. std::valarray, or std::array when the dimension is known at
+// compile time.
+    template <class P>
+    concept
+point = requires (P p, std::size_t i)
+{
+    { p.size () } -> std::convertible_to <std::size_t>;
+    p[i];
+};
+
+    template <class P>
+    using
+point_value_t = std::remove_cvref_t <decltype (std::declval <P&> ()[0])>;
+
+// The dimension, if known at compile time, 0 otherwise.
+    template <class P>
+    constexpr std::size_t
+fixed_size_v = 0;
+
+    template <class T, std::size_t N>
+    constexpr std::size_t
+fixed_size_v <std::array <T, N>> = N;
+
+// Storage for dim + Extra points: on the stack for fixed size points.
+    template <class P, std::size_t Extra>
+    using
+point_set_t = std::conditional_t <
+      fixed_size_v <P> != 0
+    , std::array <P, fixed_size_v <P> + Extra>
+    , std::vector <P>
+>;
+
+    template <class P, std::size_t Extra>
+    auto
+make_point_set (P const& prototype)
+{
+    if constexpr (fixed_size_v <P> != 0)
+    {
+            point_set_t <P, Extra>
+        s;
+        s.fill (prototype);
+        return s;
+    }
+    else
+    {
+        return point_set_t <P, Extra> (prototype.size () + Extra, prototype);
+    }
+}
+
+    template <point P>
+    auto
+dot (P const& a, P const& b)
+{
+        auto
+    r = point_value_t <P> {};
+    for (auto k = 0u; k < a.size (); ++k)
+    {
+        r += a[k] * b[k];
+    }
+    return r;
+}
+
+// Solve a x = b in place, for a symmetric positive definite n x n, row-major,
+// matrix. a is overwritten by its Cholesky factor, b by the solution. Returns
+// false if a is not (numerically) positive definite.
+    template <class Value>
+    bool
+cholesky_solve (std::span <Value> a, std::span <Value> b)
+{
+        const auto
+    n = b.size ();
+    for (auto j = 0u; j < n; ++j)
+    {
+            auto
+        d = a[j * n + j];
+        for (auto k = 0u; k < j; ++k)
+        {
+            d -= a[j * n + k] * a[j * n + k];
+        }
+        if (!(d > 0))
+        {
+            return false;
+        }
+            using std::sqrt;
+        a[j * n + j] = sqrt (d);
+        for (auto i = j + 1; i < n; ++i)
+        {
+                auto
+            s = a[i * n + j];
+            for (auto k = 0u; k < j; ++k)
+            {
+                s -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = s / a[j * n + j];
+        }
+    }
+    for (auto i = 0u; i < n; ++i)
+    {
+        for (auto k = 0u; k < i; ++k)
+        {
+            b[i] -= a[i * n + k] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    for (auto i = n; i-- > 0;)
+    {
+        for (auto k = i + 1; k < n; ++k)
+        {
+            b[i] -= a[k * n + i] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Observers: the solvers call options.observer at each evaluation of the
+// function, with an iteration_event_t (whose x is a point, for the
+// multidimensional ones), e.g. to trace them (observer.hpp). The default one
+// does nothing, and compiles away. The parallel ones call it from the calling
+// thread only: for the points evaluated in parallel, once they all are.
+    enum class
+step_t
+{
+      initial
+    , newton
+    , secant
+    , steffensen
+    , bisection
+    , inverse_quadratic
+    , quadratic
+    , cubic
+    , projection
+    // Of the other solvers.
+    , expansion
+    , sampling
+    , golden_section
+    , line_search
+    , simplex
+    , levenberg_marquardt
+    , fixed_point
+    , aberth
+    // The end of a local solve (e.g. in multistart).
+    , local_solve
+    // Of differential_evolution.
+    , evolution
+};
+
+    template <class Value, class FunctionResult>
+    struct
+iteration_event_t
+{
+        char const*
+    solver;
+        int
+    iteration;
+    // How x was chosen.
+        step_t
+    step;
+        Value
+    x;
+        FunctionResult
+    f;
+};
+
+    struct
+no_observer_t
+{
+        template <class Event>
+        constexpr void
+    operator () (Event const&) const noexcept
+    {}
+};
+
 //------------------------------------------------------------------------------
 // Newton method
     struct
@@ -113,49 +311,95 @@ NewtonTag
           class Value
         , class FunctionResult
     >
-    bool
+    constexpr bool
 newton_default_converged (
       Value            const& current
     , Value            const& past
     , FunctionResult   const& result
 ){
-        using std::fabs;
-    return fabs ((past - current) / current) < std::numeric_limits <Value>::epsilon () 
+    return constexpr_fabs ((past - current) / current) < std::numeric_limits <Value>::epsilon () 
         || result == 0;
     ;
 }
 
+// The same, as a literal type.
+    template <
+          class Value
+        , class FunctionResult
+    >
+    struct
+newton_default_converged_t
+{
+        constexpr bool
+    operator () (
+          Value            const& current
+        , Value            const& past
+        , FunctionResult   const& result
+    ) const {
+        return newton_default_converged (current, past, result);
+    }
+};
+
 // Build an alternative simple convergence predicate
     template <class Value>
-    auto
+    constexpr auto
 make_newton_simple_converged (Value const& tolerance)
 {
     return [=](auto const& current, auto const& past, auto const& result)
     {
-            using std::fabs;
-        return fabs ((past - current) / current) < tolerance || result == 0;
+        return constexpr_fabs ((past - current) / current) < tolerance || result == 0;
     };
 }
     
-// What options it can take
+// What options it can take. With a Converged type other than std::function
+// (e.g. newton_static_options_t), newton can be evaluated at compile time.
     template <
           class Value
         , class FunctionResult
         , class DerivativeResult
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
     >
     struct
 newton_options_t
 {
         int
     max_iter = 100;
-        std::function <bool (
-          Value const&
-        , Value const&
-        , FunctionResult const&
-    )>
-    converged = &newton_default_converged <Value, FunctionResult>;
+        Converged
+    converged = newton_default_converged_t <Value, FunctionResult> {};
+        [[no_unique_address]]
+        Observer
+    observer = {};
+    // Armijo backtracking: the step is halved, at most max_backtracks times,
+    // until |f| decreases enough, |f (past - t step)| <= (1 - armijo t)
+    // |f (past)|, or the function no longer throws there.
+        bool
+    backtracking = false;
+        int
+    max_backtracks = 20;
+        Value
+    armijo = Value (1e-4);
+    // The domain: the iterates are projected onto [lower, upper].
+        Value
+    lower = std::numeric_limits <Value>::lowest ();
+        Value
+    upper = std::numeric_limits <Value>::max ();
 };
 
+    template <
+          class Value
+        , class FunctionResult
+        , class DerivativeResult
+        , class Converged = newton_default_converged_t <Value, FunctionResult>
+        , class Observer = no_observer_t
+    >
+    using
+newton_static_options_t = newton_options_t <Value, FunctionResult, DerivativeResult, Converged, Observer>;
+
 // What it might throw
     using
 newton_no_convergence_e = defaults::no_convergence_e;
@@ -176,6 +420,9 @@ info::data
         zero_derivative = false;
             bool
         derivative_threw = false;
+        // Halvings of the step, with backtracking.
+            int
+        backtrack_count = 0;
     };
 
         template <
@@ -191,6 +438,8 @@ info::data
         zero_derivative = false;
             bool
         derivative_threw = false;
+            int
+        backtrack_count = 0;
             std::vector <std::tuple <
                   Value
                 , FunctionResult
@@ -232,24 +481,30 @@ info::data
         , info_tag_t InfoTag = info::tag::none
         , class FunctionResult = std::invoke_result_t <Function, Value>
         , class DerivativeResult = std::invoke_result_t <Derivative, Value>
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
     >
     requires 
            std::invocable <Function, Value> 
         && std::invocable <Derivative, Value>
-    auto
+    constexpr auto
 newton (
       Function&&       function
     , Derivative&&     derivative
     , Value const&     initial_guess
-    , newton_options_t <Value, FunctionResult, DerivativeResult> const& options = {}
+    , newton_options_t <Value, FunctionResult, DerivativeResult, Converged, Observer> const& options
     ,   [[maybe_unused]] 
       info_t <InfoTag> info = info::none
 ){
-        constexpr static auto
+        constexpr auto
     need_info_iterations = InfoTag == info::tag::iterations;
-        constexpr static auto
+        constexpr auto
     need_info_convergence = InfoTag == info::tag::convergence;;
-        constexpr static auto
+        constexpr auto
     need_info = need_info_iterations || need_info_convergence;
 
         [[maybe_unused]]
@@ -266,27 +521,48 @@ newton (
     past;
         Value
     current = initial_guess;
+        auto
+    project = [&](Value const& x)
+    {
+        return x < options.lower ? options.lower : options.upper < x ? options.upper : x;
+    };
+    // f at current, if the line search evaluated it.
+        auto
+    f_next = FunctionResult {};
+        bool
+    f_known = false;
     for (int i = 0; i < options.max_iter; ++i)
     {
             auto
-        f = FunctionResult {};
-        try 
-        {
-            f = std::forward <Function> (function) (current);
-        }
-        catch (...)
+        f = f_next;
+        if (!f_known)
         {
-            if constexpr (need_info)
+            try
             {
-                info_data.converged = false;
-                info_data.function_threw = true;
-                return std::pair { current, info_data };
+                f = std::forward <Function> (function) (current);
             }
-            else
+            catch (...)
             {
-                throw;
+                if constexpr (need_info)
+                {
+                    info_data.converged = false;
+                    info_data.function_threw = true;
+                    return std::pair { current, info_data };
+                }
+                else
+                {
+                    throw;
+                }
             }
+            options.observer (iteration_event_t <Value, FunctionResult> {
+                  "newton"
+                , i
+                , i == 0 ? step_t::initial : step_t::newton
+                , current
+                , f
+            });
         }
+        f_known = false;
             auto
         df = DerivativeResult {};
         try
@@ -320,7 +596,68 @@ newton (
             }
         }
         past = current;
-        current -= f / df;
+            const auto
+        step = f / df;
+        current = project (past - step);
+        // Against a bound of the domain.
+        if (current == past && past - step != past)
+        {
+            break;
+        }
+        if (options.backtracking)
+        {
+                auto
+            t = Value (1);
+            for (int k = 0; !f_known; ++k)
+            {
+                try
+                {
+                    f_next = std::forward <Function> (function) (current);
+                    f_known = true;
+                }
+                catch (...)
+                {
+                    if (k == options.max_backtracks)
+                    {
+                        if constexpr (need_info)
+                        {
+                            info_data.converged = false;
+                            info_data.function_threw = true;
+                            return std::pair { current, info_data };
+                        }
+                        else
+                        {
+                            throw;
+                        }
+                    }
+                }
+                if (f_known)
+                {
+                    options.observer (iteration_event_t <Value, FunctionResult> {
+                          "newton"
+                        , i + 1
+                        , step_t::newton
+                        , current
+                        , f_next
+                    });
+                    if (
+                           k < options.max_backtracks
+                        && !(constexpr_fabs (f_next) <= (1 - options.armijo * t) * constexpr_fabs (f))
+                    ){
+                        f_known = false;
+                    }
+                }
+                if (!f_known)
+                {
+                    t /= 2;
+                    current = project (past - t * step);
+                    if constexpr (need_info)
+                    {
+                        ++info_data.backtrack_count;
+                    }
+                }
+            }
+        }
         if constexpr (need_info_convergence)
         {
             info_data.convergence.push_back ({current, f, df});
@@ -352,6 +689,31 @@ newton (
     }
 }
 
+// With the default options, which need no std::function.
+    template <
+          class Function
+        , class Derivative
+        , class Value
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class DerivativeResult = std::invoke_result_t <Derivative, Value>
+    >
+    requires 
+           std::invocable <Function, Value> 
+        && std::invocable <Derivative, Value>
+    constexpr auto
+newton (
+      Function&&       function
+    , Derivative&&     derivative
+    , Value const&     initial_guess
+){
+    return newton (
+          std::forward <Function> (function)
+        , std::forward <Derivative> (derivative)
+        , initial_guess
+        , newton_static_options_t <Value, FunctionResult, DerivativeResult> {}
+    );
+}
+
 //------------------------------------------------------------------------------
 // Zhang method (i.e. better Brent).
     struct
@@ -359,23 +721,41 @@ ZhangTag
 {};
 
     template <class Value, class FunctionResult>
-    bool
+    constexpr bool
 zhang_default_converged (
       Value const& a
     , Value const& b
     , FunctionResult const& fa
     , FunctionResult const& fb
 ){
-        using std::fabs;
+    // Relative to the bracket beyond 1, where a bracket can't get narrower
+    // than epsilon.
     return
            fa == 0
         || fb == 0
-        || fabs (b - a) < std::numeric_limits <Value>::epsilon ()
+        || constexpr_fabs (b - a) <= 2 * std::numeric_limits <Value>::epsilon ()
+            * std::max ({ Value (1), Value (constexpr_fabs (a)), Value (constexpr_fabs (b)) })
     ;
 }
 
+// The same, as a literal type.
+    template <class Value, class FunctionResult>
+    struct
+zhang_default_converged_t
+{
+        constexpr bool
+    operator () (
+          Value const& a
+        , Value const& b
+        , FunctionResult const& fa
+        , FunctionResult const& fb
+    ) const {
+        return zhang_default_converged (a, b, fa, fb);
+    }
+};
+
     template <class Value>
-    auto
+    constexpr auto
 make_zhang_simple_converged (Value const& tolerance)
 {
     return [=] <class FunctionResult> (
@@ -384,30 +764,48 @@ make_zhang_simple_converged (Value const& tolerance)
         , FunctionResult const& fa
         , FunctionResult const& fb
     ) {
-            using std::fabs;
     return
            fa == 0
         || fb == 0
-        || fabs (b - a) < tolerance
+        || constexpr_fabs (b - a) < tolerance
     ;
     };
 }
 
-    template <class Value, class FunctionResult>
-    struct
-zhang_options_t
-{
-        int
-    max_iter = 100;
-        std::function <bool (
+// With a Converged type other than std::function (e.g. zhang_static_options_t),
+// zhang can be evaluated at compile time.
+    template <
+          class Value
+        , class FunctionResult
+        , class Converged = std::function <bool (
               Value const&
             , Value const&
             , FunctionResult const&
             , FunctionResult const&
         )>
-    converged = zhang_default_converged <Value, FunctionResult>;
+        , class Observer = no_observer_t
+    >
+    struct
+zhang_options_t
+{
+        int
+    max_iter = 100;
+        Converged
+    converged = zhang_default_converged_t <Value, FunctionResult> {};
+        [[no_unique_address]]
+        Observer
+    observer = {};
 };
 
+    template <
+          class Value
+        , class FunctionResult
+        , class Converged = zhang_default_converged_t <Value, FunctionResult>
+        , class Observer = no_observer_t
+    >
+    using
+zhang_static_options_t = zhang_options_t <Value, FunctionResult, Converged, Observer>;
+
     using
 zhang_no_convergence_e = defaults::no_convergence_e;
 
@@ -467,26 +865,34 @@ info::data
     };
 } // namespace info::data
 
+// With the function values at the ends of the bracket already known, e.g. from
+// bracket_root.
     template <
           class Function
         , class Value
         , info_tag_t InfoTag = info::tag::none
-        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class FunctionResult
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
     >
-    auto
+    constexpr auto
 zhang (
       Function&&  function
-    , Value       a // bracket 1
-    , Value       b // bracket 2
-    , zhang_options_t<Value, FunctionResult> const& options = {}
+    , std::tuple <Value, Value, FunctionResult, FunctionResult> const& bracket
+    , zhang_options_t <Value, FunctionResult, Converged, Observer> const& options = {}
     ,   [[maybe_unused]] 
       info_t <InfoTag> info = info::none
 ){
-        constexpr static auto
+        constexpr auto
     need_info_iterations = InfoTag == info::tag::iterations;
-        constexpr static auto
-    need_info_convergence = InfoTag == info::tag::convergence;;
-        constexpr static auto
+        constexpr auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr auto
     need_info = need_info_iterations || need_info_convergence;
 
         [[maybe_unused]]
@@ -499,44 +905,38 @@ zhang (
     > {};
 
         using std::swap;
+        auto
+    [ a, b, fa, fb ] = bracket;
     if (b < a)
     {
-            using std::swap;
         swap (a, b);
+        swap (fa, fb);
     }
-        FunctionResult
-      fa
-    , fb
-    ;
-    try
-    {
-        fa = std::forward <Function> (function) (a);
-        fb = std::forward <Function> (function) (b);
-    }
-    catch (...)
+    if (fa * fb > 0)
     {
         if constexpr (need_info)
         {
             info_data.converged = false;
-            info_data.function_threw = true;
-            return std::pair { (a + b) / 2, info_data };
+            info_data.no_single_root_between_bracket = true;
+            return std::pair { (a + b) / 2,  info_data };
         }
         else
         {
-            throw;
+            throw zhang_no_single_root_between_brackets_e {};
         }
     }
-    if (fa * fb > 0)
+    // An end of the bracket may be the root already.
+    if (fa == 0 || fb == 0)
     {
+            const auto
+        r = fa == 0 ? a : b;
         if constexpr (need_info)
         {
-            info_data.converged = false;
-            info_data.no_single_root_between_bracket = true;
-            return std::pair { (a + b) / 2,  info_data };
+            return std::pair { r, info_data };
         }
         else
         {
-            throw zhang_no_single_root_between_brackets_e {};
+            return r;
         }
     }
     for (int i = 0; i < options.max_iter; ++i)
@@ -562,6 +962,7 @@ zhang (
                 throw;
             }
         }
+        options.observer (iteration_event_t <Value, FunctionResult> { "zhang", i, step_t::bisection, c, fc });
             auto
         s = (fa != fc && fb != fc) ?
             b - fb * (b - a) / (fb - fa)
@@ -589,6 +990,13 @@ zhang (
                 throw;
             }
         }
+        options.observer (iteration_event_t <Value, FunctionResult> {
+              "zhang"
+            , i
+            , (fa != fc && fb != fc) ? step_t::secant : step_t::inverse_quadratic
+            , s
+            , fs
+        });
         if (c > s)
         {
             swap (s , c);
@@ -618,19 +1026,21 @@ zhang (
         {
             info_data.convergence.push_back ({ a, b, fa, fb });
         }
-        if (options.converged (a, b, fa, fb))
+        if (fa == 0 || fb == 0 || options.converged (a, b, fa, fb))
         {
             if constexpr (need_info_iterations)
             {
                 info_data.iteration_count = i;
             }
+                const auto
+            r = fa == 0 ? a : fb == 0 ? b : (a + b) / 2;
             if constexpr (need_info)
             {
-                return std::pair { (a + b) / 2,  info_data };
+                return std::pair { r,  info_data };
             }
             else
             {
-                return (a + b) / 2;
+                return r;
             }
         }
     }
@@ -645,12 +1055,351 @@ zhang (
     }
 };
 
-//------------------------------------------------------------------------------
-// Bracket an extremum
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Converged = std::function <bool (
+              Value const&
+            , Value const&
+            , FunctionResult const&
+            , FunctionResult const&
+        )>
+        , class Observer = no_observer_t
+    >
+    constexpr auto
+zhang (
+      Function&&  function
+    , Value       a // bracket 1
+    , Value       b // bracket 2
+    , zhang_options_t <Value, FunctionResult, Converged, Observer> const& options
+    ,   [[maybe_unused]] 
+      info_t <InfoTag> info = info::none
+){
+        constexpr auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          ZhangTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        using std::swap;
+    if (b < a)
+    {
+            using std::swap;
+        swap (a, b);
+    }
+        FunctionResult
+      fa
+    , fb
+    ;
+    try
+    {
+        fa = std::forward <Function> (function) (a);
+        fb = std::forward <Function> (function) (b);
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.converged = false;
+            info_data.function_threw = true;
+            return std::pair { (a + b) / 2, info_data };
+        }
+        else
+        {
+            throw;
+        }
+    }
+    options.observer (iteration_event_t <Value, FunctionResult> { "zhang", 0, step_t::initial, a, fa });
+    options.observer (iteration_event_t <Value, FunctionResult> { "zhang", 0, step_t::initial, b, fb });
+    return zhang (
+          std::forward <Function> (function)
+        , std::tuple { a, b, fa, fb }
+        , options
+        , info
+    );
+};
+
+// With the default options, which need no std::function.
+    template <
+          class Function
+        , class Value
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+    >
+    constexpr auto
+zhang (
+      Function&&  function
+    , Value       a // bracket 1
+    , Value       b // bracket 2
+){
+    return zhang (
+          std::forward <Function> (function)
+        , a
+        , b
+        , zhang_static_options_t <Value, FunctionResult> {}
+    );
+}
+
+//------------------------------------------------------------------------------
+// Bracket a root: from [guess, guess + step], search inward (if subdivisions >
+// 1) for a sign change, then expand geometrically the end with the smallest
+// |f| until there is one (Press et al., "Numerical Recipes", zbrak and zbrac).
+// The bracket comes with the function values at its ends, which zhang accepts.
+// An end where the function is exactly 0 is a root, and ends the search.
+    struct
+BracketRootTag
+{};
+
+    template <class Observer = no_observer_t>
+    struct
+bracket_root_options_t
+{
+        int
+    max_iter = 50;
+        double
+    growth = std::numbers::phi;
+        int
+    subdivisions = 0;
+        [[no_unique_address]]
+        Observer
+    observer = {};
+};
+
+    struct
+bracket_root_no_convergence_e
+{};
+
+    namespace
+info::data
+{
+        struct
+    bracket_root_iterations_t
+        : base_iterations_t
+    {
+            int
+        evaluation_count = 0;
+    };
+
+        template <
+              class Value
+            , class FunctionResult
+        >
+        struct
+    bracket_root_convergence_t
+        : bracket_root_iterations_t
+    {
+            std::vector <std::tuple <
+                  Value
+                , Value
+                , FunctionResult
+                , FunctionResult
+            >>
+        convergence;
+    };
+
+        template <class... Ts>
+        struct
+    select <BracketRootTag, tag::iterations, Ts...>
+    {
+            using
+        type = bracket_root_iterations_t;
+    };
+
+        template <
+              class Function
+            , class Value
+        >
+        struct
+    select <BracketRootTag, tag::convergence, Function, Value>
+    {
+            using
+        type = bracket_root_convergence_t <
+              Value
+            , std::invoke_result_t <Function, Value>
+        >;
+    };
+} // namespace info::data
+
+    template <
+          class Function
+        , class Value
+        , info_tag_t InfoTag = info::tag::none
+        , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Return = std::tuple <Value, Value, FunctionResult, FunctionResult>
+        , class Observer = no_observer_t
+    >
+    requires std::invocable <Function, Value>
+    auto
+bracket_root (
+      Function&&   function
+    , Value const& guess
+    , Value const& step
+    , bracket_root_options_t <Observer> const& options = {}
+    ,   [[maybe_unused]]
+      info_t <InfoTag> info = info::none
+){
+        constexpr static auto
+    need_info_iterations = InfoTag == info::tag::iterations;
+        constexpr static auto
+    need_info_convergence = InfoTag == info::tag::convergence;
+        constexpr static auto
+    need_info = need_info_iterations || need_info_convergence;
+
+        [[maybe_unused]]
+        auto
+    info_data = info::data::select_t <
+          BracketRootTag
+        , InfoTag
+        , Function
+        , Value
+    > {};
+
+        auto
+    evaluate = [&](Value const& x, int i, step_t kind)
+    {
+        if constexpr (need_info)
+        {
+            ++info_data.evaluation_count;
+        }
+            const FunctionResult
+        f = std::forward <Function> (function) (x);
+        options.observer (iteration_event_t <Value, FunctionResult> { "bracket_root", i, kind, x, f });
+        return f;
+    };
+        auto
+    found = [](FunctionResult const& u, FunctionResult const& v)
+    {
+        return u == 0 || v == 0 || (u < 0) != (v < 0);
+    };
+        auto
+    done = [&](Value a, Value b, FunctionResult fa, FunctionResult fb, bool converged, int i)
+    {
+        if (b < a)
+        {
+                using std::swap;
+            swap (a, b);
+            swap (fa, fb);
+        }
+        if constexpr (need_info_iterations)
+        {
+            info_data.iteration_count = i;
+        }
+        if constexpr (need_info)
+        {
+            info_data.converged = converged;
+            return std::pair { Return { a, b, fa, fb }, info_data };
+        }
+        else
+        {
+            if (!converged)
+            {
+                throw bracket_root_no_convergence_e {};
+            }
+            return Return { a, b, fa, fb };
+        }
+    };
+        auto
+    a = guess;
+        auto
+    b = guess + step;
+        FunctionResult
+      fa {}
+    , fb {}
+    ;
+    try
+    {
+        fa = evaluate (a, 0, step_t::initial);
+        fb = evaluate (b, 0, step_t::initial);
+        if constexpr (need_info_convergence)
+        {
+            info_data.convergence.push_back ({ a, b, fa, fb });
+        }
+        if (found (fa, fb))
+        {
+            return done (a, b, fa, fb, true, 0);
+        }
+        // Inward, ...
+        if (options.subdivisions > 1)
+        {
+                auto
+            x0 = a;
+                auto
+            f0 = fa;
+            for (auto k = 1; k < options.subdivisions; ++k)
+            {
+                    const auto
+                x1 = a + (b - a) * static_cast <Value> (k) / static_cast <Value> (options.subdivisions);
+                    const auto
+                f1 = evaluate (x1, 0, step_t::sampling);
+                if constexpr (need_info_convergence)
+                {
+                    info_data.convergence.push_back ({ x0, x1, f0, f1 });
+                }
+                if (found (f0, f1))
+                {
+                    return done (x0, x1, f0, f1, true, 0);
+                }
+                x0 = x1;
+                f0 = f1;
+            }
+        }
+        // ... then outward.
+        for (auto i = 0; i < options.max_iter; ++i)
+        {
+                using std::fabs;
+            if (fabs (fa) < fabs (fb))
+            {
+                a += options.growth * (a - b);
+                fa = evaluate (a, i + 1, step_t::expansion);
+            }
+            else
+            {
+                b += options.growth * (b - a);
+                fb = evaluate (b, i + 1, step_t::expansion);
+            }
+            if constexpr (need_info_convergence)
+            {
+                info_data.convergence.push_back ({ a, b, fa, fb });
+            }
+            if (found (fa, fb))
+            {
+                return done (a, b, fa, fb, true, i + 1);
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (need_info)
+        {
+            info_data.function_threw = true;
+            return done (a, b, fa, fb, false, 0);
+        }
+        else
+        {
+            throw;
+        }
+    }
+    return done (a, b, fa, fb, false, options.max_iter);
+}
+
+//------------------------------------------------------------------------------
+// Bracket an extremum
     struct
 BracketExtremaTag
 {};
 // https://stackoverflow.com/a/58876657/1622545
+    template <class Observer = no_observer_t>
     struct
 bracket_minimum_options_t 
 {
@@ -658,6 +1407,9 @@ bracket_minimum_options_t
     max_iter = 100;
         double
     gold = std::numbers::phi;
+        [[no_unique_address]]
+        Observer
+    observer = {};
 };
 
     struct
@@ -715,6 +1467,7 @@ info::data
         , info_tag_t InfoTag = info::tag::none
         , class FunctionResult = std::invoke_result_t <Function, Value>
         , class Return = std::tuple <Value, Value, FunctionResult, FunctionResult>
+        , class Observer = no_observer_t
     >
     requires std::invocable <Function, Value> 
     auto
@@ -722,7 +1475,7 @@ bracket_minimum (
       Function&& function
     , Value      a
     , Value      b
-    , bracket_minimum_options_t const& options = {}
+    , bracket_minimum_options_t <Observer> const& options = {}
     ,   [[maybe_unused]] 
       info_t <InfoTag> info = info::none
 ){
@@ -749,7 +1502,9 @@ bracket_minimum (
     try
     {
         fa = std::forward <Function> (function) (a);
+        options.observer (iteration_event_t <Value, FunctionResult> { "bracket_minimum", 0, step_t::initial, a, fa });
         fb = std::forward <Function> (function) (b);
+        options.observer (iteration_event_t <Value, FunctionResult> { "bracket_minimum", 0, step_t::initial, b, fb });
     }
     catch (...)
     {
@@ -796,6 +1551,7 @@ bracket_minimum (
                 throw;
             }
         }
+        options.observer (iteration_event_t <Value, FunctionResult> { "bracket_minimum", i + 1, step_t::expansion, c, fc });
         if constexpr (need_info_convergence)
         {
             info_data.convergence.push_back ({{{ a, fa }, { b, fb }, { c, fc }}});
@@ -838,14 +1594,18 @@ bracket_minimum (
 GoldenSectionTag
 {};
 
-    template <class Value>
+    template <class Value, class Observer = no_observer_t>
     struct
 golden_section_options_t
 {
         Value
     tolerance = std::numeric_limits <Value>::epsilon ();
-        bracket_minimum_options_t
-    bracket_minimum_options = bracket_minimum_options_t {};
+    // Its observer is this one.
+        bracket_minimum_options_t <>
+    bracket_minimum_options = {};
+        [[no_unique_address]]
+        Observer
+    observer = {};
 };
 
     using
@@ -909,6 +1669,7 @@ info::data
         , class Value
         , info_tag_t InfoTag = info::tag::none
         , class FunctionResult = std::invoke_result_t <Function, Value>
+        , class Observer = no_observer_t
     >
     requires std::invocable <Function, Value> 
     auto
@@ -916,7 +1677,7 @@ golden_section (
       Function&&        function
     , Value             a
     , Value             b
-    , golden_section_options_t <Value> const& options = {}
+    , golden_section_options_t <Value, Observer> const& options = {}
     ,   [[maybe_unused]] 
       info_t <InfoTag> info = info::none
 ){
@@ -940,6 +1701,12 @@ golden_section (
       fa
     , fb
     ;
+        const auto
+    bracket_minimum_options = bracket_minimum_options_t <Observer> {
+          options.bracket_minimum_options.max_iter
+        , options.bracket_minimum_options.gold
+        , options.observer
+    };
     if constexpr (need_info)
     {
             auto
@@ -947,7 +1714,7 @@ golden_section (
               std::forward <Function> (function)
             , a
             , b
-            , options.bracket_minimum_options
+            , bracket_minimum_options
             , info
         );
             std::tie
@@ -966,7 +1733,7 @@ golden_section (
               std::forward <Function> (function)
             , a
             , b
-            , options.bracket_minimum_options
+            , bracket_minimum_options
         );
     }
     if (a > b) 
@@ -988,7 +1755,9 @@ golden_section (
     try
     {
         fc = std::forward <Function> (function) (c);
+        options.observer (iteration_event_t <Value, FunctionResult> { "golden_section", 0, step_t::golden_section, c, fc });
         fd = std::forward <Function> (function) (d);
+        options.observer (iteration_event_t <Value, FunctionResult> { "golden_section", 0, step_t::golden_section, d, fd });
     }
     catch (...)
     {
@@ -1022,6 +1791,7 @@ golden_section (
             try
             {
                 fc = std::forward <Function> (function) (c);
+                options.observer (iteration_event_t <Value, FunctionResult> { "golden_section", i + 1, step_t::golden_section, c, fc });
             }
             catch (...)
             {
@@ -1047,6 +1817,7 @@ golden_section (
             try
             {
                 fd = std::forward <Function> (function) (d);
+                options.observer (iteration_event_t <Value, FunctionResult> { "golden_section", i + 1, step_t::golden_section, d, fd });
             }
             catch (...)
             {
@@ -1092,13 +1863,234 @@ golden_section (
     }
 }
 
+//------------------------------------------------------------------------------
+// A cache of function evaluations, keyed by the exact bits of the argument (a
+// scalar, or a point whose dimension is set at construction). Fixed size, open
+// addressing with a few probes, an evaluation evicting the one in its home
+// slot when they are all taken: it only allocates at construction.
+    template <
+          class Value
+        , class Result
+        , std::size_t Size = 64
+    >
+    requires (Size > 0 && (Size & (Size - 1)) == 0)
+    class
+evaluation_cache_t
+{
+        constexpr static std::size_t
+    probes = 4;
+        std::size_t
+    dimension;
+        std::vector <Value>
+    keys;
+        std::array <Result, Size>
+    results = {};
+        std::array <bool, Size>
+    used = {};
+
+        template <class Key>
+        static Value
+    component (Key const& x, std::size_t k)
+    {
+        if constexpr (point <Key>)
+        {
+            return x[k];
+        }
+        else
+        {
+            return x;
+        }
+    }
+
+    public:
+        int
+      hits = 0
+    , misses = 0
+    ;
+
+    explicit
+    evaluation_cache_t (std::size_t dimension = 1)
+        : dimension { dimension }
+        , keys (Size * dimension)
+    {}
+
+        template <class Function, class Key>
+        Result
+    operator () (Function&& function, Key const& x)
+    {
+        // FNV-1a of the bits of the argument.
+            std::uint64_t
+        hash = 14695981039346656037ull;
+        for (auto k = 0u; k < dimension; ++k)
+        {
+                const auto
+            v = component (x, k);
+                unsigned char
+            bytes[sizeof (Value)];
+            std::memcpy (bytes, &v, sizeof v);
+            for (auto b: bytes)
+            {
+                hash = (hash ^ b) * 1099511628211ull;
+            }
+        }
+            const auto
+        home = static_cast <std::size_t> (hash) & (Size - 1);
+        // Where a miss goes: the first free slot of the probes, else home.
+            auto
+        slot = home;
+        for (auto i = 0u; i < probes; ++i)
+        {
+                const auto
+            probe = (home + i) & (Size - 1);
+            if (!used[probe])
+            {
+                slot = probe;
+                break;
+            }
+                auto
+            same = true;
+            for (auto k = 0u; k < dimension && same; ++k)
+            {
+                    const auto
+                v = component (x, k);
+                same = std::memcmp (&keys[probe * dimension + k], &v, sizeof v) == 0;
+            }
+            if (same)
+            {
+                ++hits;
+                return results[probe];
+            }
+        }
+        ++misses;
+            const Result
+        r = function (x);
+        for (auto k = 0u; k < dimension; ++k)
+        {
+            keys[slot * dimension + k] = component (x, k);
+        }
+        results[slot] = r;
+        used[slot] = true;
+        return r;
+    }
+};
+
+// Wraps function in cache, e.g. for golden_section or bracket_minimum.
+    template <
+          class Function
+        , class Value
+        , class Result
+        , std::size_t Size
+    >
+    auto
+make_cached (Function& function, evaluation_cache_t <Value, Result, Size>& cache)
+{
+    return [&](auto const& x){ return cache (function, x); };
+}
+
+//------------------------------------------------------------------------------
+// Budgets: a maximum number of evaluations, a deadline and a cancellation
+// token, checked before each evaluation of the function, hence also in the
+// nested solvers (e.g. the line searches of powell).
+    class
+cancellation_token_t
+{
+        std::atomic <bool>
+    cancelled_ = false;
+
+    public:
+        void
+    cancel () noexcept
+    {
+        cancelled_.store (true, std::memory_order_relaxed);
+    }
+
+        bool
+    cancelled () const noexcept
+    {
+        return cancelled_.load (std::memory_order_relaxed);
+    }
+};
+
+    struct
+budget_t
+{
+    // 0 for no limit.
+        long
+    max_evaluations = 0;
+        std::chrono::steady_clock::time_point
+    deadline = std::chrono::steady_clock::time_point::max ();
+        cancellation_token_t const*
+    cancellation = nullptr;
+};
+
+    namespace
+budget_detail
+{
+    // Thrown through the nested solvers when the budget is spent.
+        struct
+    spent_e
+    {};
+
+        class
+    tracker_t
+    {
+            budget_t
+        budget;
+            bool
+        spent_ = false;
+
+        public:
+            long
+        evaluations = 0;
+
+        explicit
+        tracker_t (budget_t const& budget)
+            : budget { budget }
+        {}
+
+            bool
+        limited () const
+        {
+            return budget.max_evaluations > 0
+                || budget.deadline != std::chrono::steady_clock::time_point::max ()
+                || budget.cancellation
+            ;
+        }
+
+        // Before an evaluation.
+            void
+        charge ()
+        {
+            spent_ = spent_
+                || (budget.max_evaluations > 0 && evaluations >= budget.max_evaluations)
+                || (budget.cancellation && budget.cancellation->cancelled ())
+                || (
+                       budget.deadline != std::chrono::steady_clock::time_point::max ()
+                    && std::chrono::steady_clock::now () >= budget.deadline
+                   )
+            ;
+            if (spent_)
+            {
+                throw spent_e {};
+            }
+            ++evaluations;
+        }
+
+            bool
+        spent () const
+        {
+            return spent_;
+        }
+    };
+} // namespace budget_detail
+
 //------------------------------------------------------------------------------
 // Powell
     struct
 PowellTag
 {};
 
-    template <class Value, class FunctionResult>
+    template <class Value, class FunctionResult, class Observer = no_observer_t>
     struct
 powell_options_t
 {
@@ -1108,11 +2100,37 @@ powell_options_t
     tolerance = std::numeric_limits <FunctionResult>::epsilon ();
         golden_section_options_t <Value>
     golden_section_options = {};
+    // Keep the last evaluations in an evaluation_cache_t: each line search
+    // starts from the current point, whose value is known.
+        bool
+    cache = false;
+    // Where the info::convergence data is allocated, e.g. an arena
+    // (std::pmr::monotonic_buffer_resource). The default resource if null.
+        std::pmr::memory_resource*
+    memory_resource = nullptr;
+    // Once it is spent, the best point so far is returned.
+        budget_t
+    budget = {};
+    // At each evaluation, but those found in the cache.
+        [[no_unique_address]]
+        Observer
+    observer = {};
 };
 
     using
 powell_no_convergence_e = defaults::no_convergence_e;
 
+// Without info, once the budget is spent.
+    template <class Value, class FunctionResult>
+    struct
+powell_budget_exhausted_e
+{
+        std::valarray <Value>
+    best;
+        FunctionResult
+    f_best;
+};
+
     namespace
 info::data
 {
@@ -1120,10 +2138,21 @@ info::data
     powell_iterations_t
         : base_iterations_t
     {
+        // Of the last line search.
             golden_section_iterations_t
         golden_section_info;
+            int
+          cache_hits = 0
+        , cache_misses = 0
+        ;
+            bool
+        budget_exhausted = false;
+            long
+        evaluation_count = 0;
     };
 
+    // In columns, all in the same memory resource, so that a run allocates
+    // little, and nothing but in the resource.
         template <
               class Function
             , class Value
@@ -1133,10 +2162,98 @@ info::data
     powell_convergence_t
         : base_t
     {
-            std::vector <golden_section_convergence_t <Value, FunctionResult>>
-        golden_section_info;
-            std::vector <std::tuple <int, int, FunctionResult, std::valarray <Value>>>
-        convergence;
+        explicit
+        powell_convergence_t (std::pmr::memory_resource* resource = std::pmr::get_default_resource ())
+        // With parentheses: braces would make line_search_converged { true }.
+            : iteration (resource)
+            , direction (resource)
+            , f (resource)
+            , points (resource)
+            , line_search_converged (resource)
+            , line_search_begin (resource)
+            , t (resource)
+            , ft (resource)
+        {}
+
+        // A row per step, after its line search: the iteration, the direction
+        // (n for the extra one), the value, and the point, dimension values
+        // from dimension * row in points.
+            std::size_t
+        dimension = 0;
+            std::pmr::vector <int>
+          iteration
+        , direction
+        ;
+            std::pmr::vector <FunctionResult>
+        f;
+            std::pmr::vector <Value>
+        points;
+        // A row per line search: whether it converged, and where its
+        // evaluations, (t, f (p + t direction)), start in t and ft.
+            std::pmr::vector <bool>
+        line_search_converged;
+            std::pmr::vector <std::size_t>
+        line_search_begin;
+            std::pmr::vector <Value>
+        t;
+            std::pmr::vector <FunctionResult>
+        ft;
+            int
+          cache_hits = 0
+        , cache_misses = 0
+        ;
+            bool
+        budget_exhausted = false;
+            long
+        evaluation_count = 0;
+
+            std::size_t
+        size () const
+        {
+            return f.size ();
+        }
+
+            std::span <Value const>
+        point (std::size_t row) const
+        {
+            return { points.data () + row * dimension, dimension };
+        }
+
+        // A row of the steps, flattened: the iteration, the direction, the
+        // value and the point, columns () values in all, e.g. for
+        // failure_recorder_t.
+            std::size_t
+        columns () const
+        {
+            return 3 + dimension;
+        }
+
+            template <class Visit>
+            void
+        visit_row (std::size_t row, Visit&& visit) const
+        {
+            visit (iteration[row]);
+            visit (direction[row]);
+            visit (f[row]);
+            for (auto const& x: point (row))
+            {
+                visit (x);
+            }
+        }
+
+        // The evaluations of a line search.
+            std::pair <std::span <Value const>, std::span <FunctionResult const>>
+        line_search (std::size_t k) const
+        {
+                const auto
+            begin = line_search_begin[k];
+                const auto
+            end = k + 1 < line_search_begin.size () ? line_search_begin[k + 1] : t.size ();
+            return {
+                  std::span { t }.subspan (begin, end - begin)
+                , std::span { ft }.subspan (begin, end - begin)
+            };
+        }
     };
 
         template <class... Ts>
@@ -1171,13 +2288,14 @@ info::data
         , class Value
         , info_tag_t InfoTag = info::tag::none
         , class FunctionResult = std::invoke_result_t <Function, std::valarray <Value>>
+        , class Observer = no_observer_t
     >
     requires std::invocable <Function, std::valarray <Value>>
     auto
 powell (
       Function                function
     , std::valarray <Value>&& init
-    , powell_options_t <Value, FunctionResult> const& options = {}
+    , powell_options_t <Value, FunctionResult, Observer> const& options = {}
     ,   [[maybe_unused]] 
       info_t <InfoTag> info = info::none
 ){
@@ -1188,17 +2306,35 @@ powell (
         constexpr static auto
     need_info = need_info_iterations || need_info_convergence;
 
-        [[maybe_unused]]
-        auto
-    info_data = info::data::select_t <
+        using
+    info_data_t = info::data::select_t <
           PowellTag
         , InfoTag
         , Function
         , Value
-    > {};
+    >;
+        [[maybe_unused]]
+        auto
+    info_data = [&]
+    {
+        if constexpr (need_info_convergence)
+        {
+            return info_data_t {
+                options.memory_resource ? options.memory_resource : std::pmr::get_default_resource ()
+            };
+        }
+        else
+        {
+            return info_data_t {};
+        }
+    } ();
 
         const auto
     n = init.size ();
+    if constexpr (need_info_convergence)
+    {
+        info_data.dimension = n;
+    }
         auto
     xi = std::valarray (std::valarray (0., n), n);
     for (auto i = 0u; i < n; ++i)
@@ -1207,139 +2343,223 @@ powell (
     }
         auto
     p = std::valarray (init);
-        FunctionResult
-    f;
-    if constexpr (need_info)
+    // A row of convergence info.
+        [[maybe_unused]]
+        auto
+    push_step = [&](int j, int i, FunctionResult const& f)
     {
-        try
+        if constexpr (need_info_convergence)
         {
-            f = function (p);
+            info_data.iteration.push_back (j);
+            info_data.direction.push_back (i);
+            info_data.f.push_back (f);
+            info_data.points.insert (info_data.points.end (), std::begin (p), std::end (p));
         }
-        catch (...)
+    };
+        auto
+    cache = evaluation_cache_t <Value, FunctionResult> { options.cache ? n : 0 };
+        auto
+    tracker = budget_detail::tracker_t { options.budget };
+    // With a budget, the best point so far.
+        auto
+    best = std::valarray <Value> {};
+        auto
+    f_best = std::numeric_limits <FunctionResult>::max ();
+        auto
+    j = 0;
+        auto
+    call = [&](std::valarray <Value> const& x) -> FunctionResult
+    {
+        tracker.charge ();
+            const FunctionResult
+        f = function (x);
+        options.observer (iteration_event_t <std::valarray <Value>, FunctionResult> {
+              "powell"
+            , j
+            , j == 0 ? step_t::initial : step_t::line_search
+            , x
+            , f
+        });
+        return f;
+    };
+        auto
+    evaluate = [&](std::valarray <Value> const& x) -> FunctionResult
+    {
+            const auto
+        f = options.cache ? cache (call, x) : call (x);
+        if (tracker.limited () && (best.size () == 0 || f < f_best))
         {
-            info_data.converged = false;
-            info_data.function_threw = true;
-            return std::pair { p, info_data };
+            best = x;
+            f_best = f;
         }
-    }
-    for (int j = 1; j <= options.max_iter; ++j)
+        return f;
+    };
+    // Once the budget is spent, with info, the best point so far is the
+    // result.
+        auto
+    exhausted = [&]
     {
-            auto 
-        p0 = p;
-            auto
-        f0 = f;
-            auto
-        delta = std::numeric_limits <Value>::min ();
-            auto
-        max_index = 0;
-        for (auto i = 0u; i < n; ++i)
+        if constexpr (need_info)
         {
-                auto
-            f_ = [&](auto lambda){ return function (p + lambda * xi[i]); };
-                Value
-            lambda;
-            if constexpr (need_info)
+            info_data.budget_exhausted = true;
+            if (best.size () != 0)
             {
-                    auto
-                [ lam, inf ] = golden_section (f_, 0., 0.1, options.golden_section_options, info);
-                info_data.golden_section_info.push_back (std::move (inf));
-                if (!info_data.golden_section_info.back ().converged)
-                {
-                    info_data.converged = false;
-                    return std::pair { p, info_data };
-                }
-                lambda = std::move (lam);
+                p = best;
             }
-            else
-            {
-                lambda = golden_section (f_, 0., 0.1, options.golden_section_options);
-            }
-            p += lambda * xi[i];
-                const auto
-            f_prev = f;
-            if constexpr (need_info)
+        }
+        else
+        {
+            throw powell_budget_exhausted_e <Value, FunctionResult> {
+                  best.size () != 0 ? best : p
+                , f_best
+            };
+        }
+    };
+        auto
+    done = [&](bool converged, int j)
+    {
+        if constexpr (need_info)
+        {
+            if constexpr (need_info_iterations)
             {
-                try
-                {
-                    f = function (p);
-                }
-                catch (...)
-                {
-                    info_data.converged = false;
-                    info_data.function_threw = true;
-                    return std::pair { p, info_data };
-                }
+                info_data.iteration_count = j;
             }
-            if (f_prev - f > delta)
+            info_data.converged = converged;
+            info_data.cache_hits = cache.hits;
+            info_data.cache_misses = cache.misses;
+            info_data.evaluation_count = tracker.evaluations;
+            return std::pair { p, std::move (info_data) };
+        }
+        else
+        {
+            if (!converged)
             {
-                delta = f_prev - f;
-                max_index = i;
+                throw powell_no_convergence_e {};
             }
+            return p;
+        }
+    };
+    // Minimizes along direction, from p. False if the line search failed.
+        auto
+    line_search = [&](std::valarray <Value> const& direction, Value& lambda)
+    {
+            auto
+        f_ = [&](auto t)
+        {
+                const auto
+            f = evaluate (p + t * direction);
             if constexpr (need_info_convergence)
             {
-                info_data.convergence.push_back ({j, i, f, p});
+                info_data.t.push_back (t);
+                info_data.ft.push_back (f);
             }
+            return f;
+        };
+        if constexpr (need_info_convergence)
+        {
+            info_data.line_search_begin.push_back (info_data.t.size ());
+                auto
+            [ lam, inf ] = golden_section (f_, 0., 0.1, options.golden_section_options, info::iterations);
+            lambda = std::move (lam);
+            info_data.line_search_converged.push_back (inf.converged);
+            return inf.converged;
         }
-            const auto
-        f3 = function (2. * p - p0);
-        if (f3 < f0 && (f0 - 2. * f + f3) 
-            * pow (f0 - f - delta, 2.) < 0.5 * pow (f0 - f3, 2.)
-        ){
-                const auto
-            xi_ = p - p0;
+        else if constexpr (need_info)
+        {
                 auto
-            f_ = [&](auto lambda){ return function (p + lambda * xi_); };
-                Value
-            lambda;
-            if constexpr (need_info)
+            [ lam, inf ] = golden_section (f_, 0., 0.1, options.golden_section_options, info);
+            lambda = std::move (lam);
+            info_data.golden_section_info = std::move (inf);
+            return info_data.golden_section_info.converged;
+        }
+        else
+        {
+            lambda = golden_section (f_, 0., 0.1, options.golden_section_options);
+            return true;
+        }
+    };
+    try
+    {
+            auto
+        f = evaluate (p);
+        for (j = 1; j <= options.max_iter; ++j)
+        {
+                auto 
+            p0 = p;
+                auto
+            f0 = f;
+                auto
+            delta = std::numeric_limits <Value>::min ();
+                auto
+            max_index = 0;
+            for (auto i = 0u; i < n; ++i)
             {
-                    auto
-                [ lam, inf ] = golden_section (f_, 0., 0.1, options.golden_section_options, info);
-                info_data.golden_section_info.push_back (std::move (inf));
-                if (!info_data.golden_section_info.back ().converged)
+                    Value
+                lambda;
+                if (!line_search (xi[i], lambda))
                 {
-                    info_data.converged = false;
-                    return std::pair { p, info_data };
+                    if (tracker.spent ())
+                    {
+                        exhausted ();
+                    }
+                    return done (false, j);
                 }
-                lambda = std::move (lam);
-            }
-            else
-            {
-                lambda = golden_section (f_, 0., 0.1, options.golden_section_options);
-            }
-            xi[max_index] = xi_;
-            p += lambda * xi_;
-            if constexpr (need_info)
-            {
-                try
+                p += lambda * xi[i];
+                    const auto
+                f_prev = f;
+                f = evaluate (p);
+                if (f_prev - f > delta)
                 {
-                    f = function (p);
+                    delta = f_prev - f;
+                    max_index = i;
                 }
-                catch (...)
+                push_step (j, static_cast <int> (i), f);
+            }
+                const auto
+            f3 = evaluate (2. * p - p0);
+            if (f3 < f0 && (f0 - 2. * f + f3) 
+                * pow (f0 - f - delta, 2.) < 0.5 * pow (f0 - f3, 2.)
+            ){
+                    const auto
+                xi_ = std::valarray <Value> (p - p0);
+                    Value
+                lambda;
+                if (!line_search (xi_, lambda))
                 {
-                    info_data.converged = false;
-                    info_data.function_threw = true;
-                    return std::pair { p, info_data };
+                    if (tracker.spent ())
+                    {
+                        exhausted ();
+                    }
+                    return done (false, j);
                 }
+                xi[max_index] = xi_;
+                p += lambda * xi_;
+                f = evaluate (p);
+                push_step (j, static_cast <int> (n), f);
             }
-            if constexpr (need_info_convergence)
+            if (fabs (f - f0) < options.tolerance)
             {
-                info_data.convergence.push_back ({j, n, f, p});
+                return done (true, j);
             }
         }
-        if (fabs (f - f0) < options.tolerance)
+    }
+    catch (...)
+    {
+        if (tracker.spent ())
+        {
+            exhausted ();
+            return done (false, j);
+        }
+        if constexpr (need_info)
         {
-            if constexpr (need_info)
-            {
-                return std::pair { p, info_data };
-            }
-            else
-            {
-                return p;
-            }
+            info_data.function_threw = true;
+            return done (false, j);
+        }
+        else
+        {
+            throw;
         }
     }
-    info_data.converged = false;
-    return std::pair { p, info_data };
+    return done (false, options.max_iter);
 }
 } // namespace calculisto::root_finding
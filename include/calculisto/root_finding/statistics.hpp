@@ -0,0 +1,251 @@
+#pragma once
+#include "root_finding.hpp"
+#include "parallel.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+    namespace
+calculisto::root_finding
+{
+//------------------------------------------------------------------------------
+// Statistics of many solves, e.g. of those of a call site: how many, how they
+// failed, and histograms of their iterations, evaluations and durations. The
+// sink is fed from the info of the solvers (info::iterations or
+// info::convergence), from any number of threads: each thread adds to its own
+// cache lines, without lock, and they are summed when the statistics are read.
+//
+//     static auto sink = statistics_sink_t {};
+//     auto [ x, info ] = record_solve (sink, [&]{ return zhang (f, a, b, {}, info::iterations); });
+
+// The histograms are in powers of two: bucket k counts the values v with
+// std::bit_width (v) == k, i.e. 0 for k = 0, and [2^(k-1), 2^k) otherwise.
+    struct
+solve_statistics_t
+{
+        constexpr static std::size_t
+    buckets = 64;
+        using
+    histogram_t = std::array <std::uint64_t, buckets>;
+
+        std::uint64_t
+      solves = 0
+    , converged = 0
+    , function_threw = 0
+    , derivative_threw = 0
+    , zero_derivative = 0
+    , no_single_root_between_bracket = 0
+    ;
+        histogram_t
+      iterations = {}
+    , evaluations = {}
+    , nanoseconds = {}
+    ;
+
+    // An upper bound of the q-quantile (0 <= q <= 1) of a histogram: the
+    // largest value of the bucket it falls in.
+        static std::uint64_t
+    quantile (histogram_t const& histogram, double q)
+    {
+            std::uint64_t
+        total = 0;
+        for (auto n: histogram)
+        {
+            total += n;
+        }
+            const auto
+        rank = std::max (std::uint64_t { 1 }, static_cast <std::uint64_t> (std::ceil (q * static_cast <double> (total))));
+            std::uint64_t
+        seen = 0;
+        for (auto k = 0u; k < buckets; ++k)
+        {
+            seen += histogram[k];
+            if (seen >= rank)
+            {
+                return k == 0 ? 0 : (std::uint64_t { 1 } << k) - 1;
+            }
+        }
+        return 0;
+    }
+};
+
+    namespace
+statistics_detail
+{
+        constexpr std::size_t
+    cache_line = 64;
+
+    // Each thread gets the next slot, once.
+        inline std::size_t
+    thread_slot ()
+    {
+            static std::atomic <std::size_t>
+        next = 0;
+            thread_local const std::size_t
+        slot = next.fetch_add (1, std::memory_order_relaxed);
+        return slot;
+    }
+
+        inline std::size_t
+    bucket (std::uint64_t v)
+    {
+        return std::min <std::size_t> (std::bit_width (v), solve_statistics_t::buckets - 1);
+    }
+} // namespace statistics_detail
+
+    class
+statistics_sink_t
+{
+        using
+    counter_t = std::atomic <std::uint64_t>;
+
+        using
+    histogram_t = std::array <counter_t, solve_statistics_t::buckets>;
+
+    // The counters of (usually) one thread, on cache lines of their own.
+        struct alignas (statistics_detail::cache_line)
+    slot_t
+    {
+            counter_t
+          solves = 0
+        , converged = 0
+        , function_threw = 0
+        , derivative_threw = 0
+        , zero_derivative = 0
+        , no_single_root_between_bracket = 0
+        ;
+            histogram_t
+          iterations = {}
+        , evaluations = {}
+        , nanoseconds = {}
+        ;
+    };
+
+        std::size_t
+    size;
+        std::unique_ptr <slot_t[]>
+    slots;
+
+        static void
+    add (counter_t& counter, std::uint64_t n = 1)
+    {
+        counter.fetch_add (n, std::memory_order_relaxed);
+    }
+
+        static std::uint64_t
+    load (counter_t const& counter)
+    {
+        return counter.load (std::memory_order_relaxed);
+    }
+
+    public:
+    // With more threads than slots, some threads share a slot: still correct,
+    // but not contention free.
+    explicit
+    statistics_sink_t (std::size_t slots = default_thread_count ())
+        : size { std::max (slots, std::size_t { 1 }) }
+        , slots { std::make_unique <slot_t[]> (size) }
+    {}
+
+    // From the info of a solve, and how long it took.
+        template <class Info>
+        void
+    record (Info const& info, std::chrono::nanoseconds duration = {})
+    {
+            auto&
+        slot = slots[statistics_detail::thread_slot () % size];
+        add (slot.solves);
+        if (info.converged)
+        {
+            add (slot.converged);
+        }
+        if (info.function_threw)
+        {
+            add (slot.function_threw);
+        }
+        if constexpr (requires { info.derivative_threw; })
+        {
+            if (info.derivative_threw)
+            {
+                add (slot.derivative_threw);
+            }
+        }
+        if constexpr (requires { info.zero_derivative; })
+        {
+            if (info.zero_derivative)
+            {
+                add (slot.zero_derivative);
+            }
+        }
+        if constexpr (requires { info.no_single_root_between_bracket; })
+        {
+            if (info.no_single_root_between_bracket)
+            {
+                add (slot.no_single_root_between_bracket);
+            }
+        }
+        // The convergence infos of some solvers derive from their iterations
+        // ones, but only fill iteration_count with info::iterations: their
+        // history is what counts.
+        if constexpr (requires { info.convergence.size (); })
+        {
+            add (slot.iterations[statistics_detail::bucket (info.convergence.size ())]);
+        }
+        else if constexpr (requires { info.iteration_count; })
+        {
+            add (slot.iterations[statistics_detail::bucket (static_cast <std::uint64_t> (info.iteration_count))]);
+        }
+        if constexpr (requires { info.evaluation_count; })
+        {
+            add (slot.evaluations[statistics_detail::bucket (static_cast <std::uint64_t> (info.evaluation_count))]);
+        }
+        add (slot.nanoseconds[statistics_detail::bucket (static_cast <std::uint64_t> (std::max (duration.count (), decltype (duration.count ()) { 0 })))]);
+    }
+
+    // The sum of the slots, while they may still be written to.
+        solve_statistics_t
+    snapshot () const
+    {
+            auto
+        s = solve_statistics_t {};
+        for (auto i = 0u; i < size; ++i)
+        {
+                auto const&
+            slot = slots[i];
+            s.solves += load (slot.solves);
+            s.converged += load (slot.converged);
+            s.function_threw += load (slot.function_threw);
+            s.derivative_threw += load (slot.derivative_threw);
+            s.zero_derivative += load (slot.zero_derivative);
+            s.no_single_root_between_bracket += load (slot.no_single_root_between_bracket);
+            for (auto k = 0u; k < solve_statistics_t::buckets; ++k)
+            {
+                s.iterations[k] += load (slot.iterations[k]);
+                s.evaluations[k] += load (slot.evaluations[k]);
+                s.nanoseconds[k] += load (slot.nanoseconds[k]);
+            }
+        }
+        return s;
+    }
+};
+
+// Calls solve, which returns a result and an info (e.g. a solver called with
+// info::iterations), times it, records it in sink, and returns what it returns.
+    template <class Solve>
+    auto
+record_solve (statistics_sink_t& sink, Solve&& solve)
+{
+        const auto
+    start = std::chrono::steady_clock::now ();
+        auto
+    r = std::forward <Solve> (solve) ();
+    sink.record (
+          std::get <1> (r)
+        , std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start)
+    );
+    return r;
+}
+} // namespace calculisto::root_finding
@@ -0,0 +1,84 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/all_roots.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+TEST_CASE("All roots")
+{
+        auto
+    ar_sin = [](double x){ return std::sin (x); };
+    SUBCASE("all_roots")
+    {
+            auto
+        r = all_roots (ar_sin, -1., 10.);
+        CHECK(r.size () == 4);
+        CHECK(r[0] == doctest::Approx { 0. });
+        CHECK(r[1] == doctest::Approx { std::numbers::pi });
+        CHECK(r[2] == doctest::Approx { 2. * std::numbers::pi });
+        CHECK(r[3] == doctest::Approx { 3. * std::numbers::pi });
+    }
+    SUBCASE("all_roots, roots on the sampling grid")
+    {
+            auto
+        r = all_roots ([](double x){ return x * (x - 1.) * (x - 2.); }, 0., 2., { .samples = 4 });
+        CHECK(r == std::vector { 0., 1., 2. });
+    }
+    SUBCASE("all_roots, close roots, found by subdivision")
+    {
+        // Two roots, 1e-3 apart, within a single initial subinterval.
+            auto
+        f = [](double x){ return (x - 0.4) * (x - 0.401); };
+            auto
+        r = all_roots (f, 0., 1., { .samples = 4 });
+        CHECK(r.size () == 2);
+            auto
+        s = all_roots (f, 0., 1., { .samples = 4, .lipschitz = 2. });
+        CHECK(s.size () == 2);
+        CHECK(s[0] == doctest::Approx { 0.4 });
+        CHECK(s[1] == doctest::Approx { 0.401 });
+    }
+    SUBCASE("all_roots, single thread")
+    {
+            auto
+        r = all_roots (ar_sin, -1., 10., { .threads = 1 });
+        CHECK(r.size () == 4);
+    }
+    SUBCASE("all_roots, no root")
+    {
+        CHECK(all_roots ([](double x){ return x * x + 1.; }, -1., 1.).empty ());
+    }
+    SUBCASE("all_roots, user function throws")
+    {
+        CHECK_THROWS_AS(
+              all_roots ([](double x){ if (x > 0.5) throw int {}; return x; }, 0., 1.)
+            , int
+        );
+    }
+    SUBCASE("all_roots, with info (iteration count)")
+    {
+            auto const
+        [ result, info ] = all_roots (ar_sin, -1., 10., {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.bracket_count == 4);
+        CHECK(info.evaluation_count >= 65);
+        CHECK(info.iteration_count > 4);
+    }
+    SUBCASE("all_roots, with info (convergence)")
+    {
+            auto const
+        [ result, info ] = all_roots (ar_sin, -1., 10., { .zhang_options = { .max_iter = 1 } }, info::convergence);
+        CHECK(!info.converged);
+        CHECK(info.brackets.size () == 4);
+        for (auto&& [ a, b, fa, fb ]: info.brackets)
+        {
+            MESSAGE (a, ", ", b, ", ", fa, ", ", fb);
+        }
+    }
+    SUBCASE("all_roots, user function throws, with info")
+    {
+            auto const
+        [ result, info ] = all_roots ([](double) -> double { throw int {}; }, 0., 1., {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.function_threw);
+    }
+}
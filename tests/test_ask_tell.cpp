@@ -0,0 +1,185 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/ask_tell.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+#include <vector>
+
+    namespace
+{
+        auto
+    at_f = [](double x){ return std::cos (x) - x * x * x; };
+        auto
+    at_df = [](double x){ return -std::sin (x) - 3 * x * x; };
+}
+
+TEST_CASE("Ask tell")
+{
+    SUBCASE("newton_solver_t")
+    {
+            auto
+        s = newton_solver_t { 1. };
+        while (!s.done ())
+        {
+                const auto
+            x = s.ask ();
+            s.tell (at_f (x), at_df (x));
+        }
+            const auto
+        [ r, info ] = newton (at_f, at_df, 1., {}, info::iterations);
+        CHECK(s.status () == solver_status_t::converged);
+        CHECK(s.result () == r);
+        CHECK(s.info ().converged);
+        CHECK(s.info ().iteration_count == info.iteration_count);
+    }
+    SUBCASE("newton_solver_t, zero derivative, no convergence")
+    {
+            auto
+        s = newton_solver_t { 1. };
+        s.tell (1., 0.);
+        CHECK(s.status () == solver_status_t::zero_derivative);
+        CHECK(s.info ().zero_derivative);
+            auto
+        t = newton_solver_t { 1., { .max_iter = 3 } };
+        while (!t.done ())
+        {
+            t.tell (1., 1e-9);
+        }
+        CHECK(t.status () == solver_status_t::no_convergence);
+        CHECK(!t.info ().converged);
+    }
+    SUBCASE("newton_solver_t, backtracking")
+    {
+            auto
+        at = [](double x){ return std::atan (x); };
+            auto
+        dat = [](double x){ return 1 / (1 + x * x); };
+            auto
+        s = newton_solver_t { 3., { .backtracking = true, .lower = -10, .upper = 10 } };
+        while (!s.done ())
+        {
+                const auto
+            x = s.ask ();
+            s.tell (at (x), dat (x));
+        }
+            const auto
+        [ r, info ] = newton (at, dat, 3., { .backtracking = true, .lower = -10, .upper = 10 }, info::iterations);
+        CHECK(s.status () == solver_status_t::converged);
+        CHECK(s.result () == r);
+        CHECK(s.info ().iteration_count == info.iteration_count);
+        CHECK(s.info ().backtrack_count == info.backtrack_count);
+    }
+    SUBCASE("newton_solver_t, backtracking, not evaluable")
+    {
+        // As newton, which reports that the function threw at the last
+        // backtrack.
+            auto
+        lg = [](double x){ return x <= 0 ? std::nan ("") : std::log (x) - 1; };
+            auto
+        dlg = [](double x){ return 1 / x; };
+            auto
+        s = newton_solver_t { 10., { .backtracking = true, .max_backtracks = 0 } };
+        while (!s.done ())
+        {
+                const auto
+            x = s.ask ();
+            s.tell (lg (x), dlg (x));
+        }
+        CHECK(s.status () == solver_status_t::function_threw);
+        CHECK(s.info ().function_threw);
+        CHECK(!s.info ().converged);
+            auto
+        throws = [](double x){ if (x <= 0) throw 0; return std::log (x) - 1; };
+            auto const
+        [ r, info ] = newton (throws, dlg, 10., { .backtracking = true, .max_backtracks = 0 }, info::iterations);
+        CHECK(info.function_threw);
+    }
+    SUBCASE("zhang_solver_t")
+    {
+            auto
+        s = zhang_solver_t { 0., 10. };
+            auto
+        evaluations = 0;
+        while (!s.done ())
+        {
+            s.tell (at_f (s.ask ()));
+            ++evaluations;
+        }
+            auto
+        count = 0;
+            const auto
+        [ r, info ] = zhang ([&](double x){ ++count; return at_f (x); }, 0., 10., {}, info::iterations);
+        CHECK(s.status () == solver_status_t::converged);
+        CHECK(s.result () == r);
+        CHECK(s.info ().iteration_count == info.iteration_count);
+        CHECK(evaluations == count);
+    }
+    SUBCASE("zhang_solver_t, from a bracket, no single root")
+    {
+            auto
+        s = zhang_solver_t { std::tuple { 10., 0., at_f (10.), at_f (0.) } };
+        CHECK(!s.done ());
+        while (!s.done ())
+        {
+            s.tell (at_f (s.ask ()));
+        }
+        CHECK(s.result () == doctest::Approx { zhang (at_f, 0., 10.) });
+            auto
+        t = zhang_solver_t { 0., 0.1 };
+        t.tell (at_f (t.ask ()));
+        t.tell (at_f (t.ask ()));
+        CHECK(t.status () == solver_status_t::no_single_root_between_brackets);
+        CHECK(t.info ().no_single_root_between_bracket);
+    }
+    SUBCASE("zhang_solver_t, an end is the root")
+    {
+            auto
+        line = [](double x){ return x - 1; };
+            auto
+        s = zhang_solver_t { 1., 3. };
+        s.tell (line (s.ask ()));
+        s.tell (line (s.ask ()));
+        CHECK(s.status () == solver_status_t::converged);
+        CHECK(s.result () == 1.);
+            auto
+        t = zhang_solver_t { std::tuple { -3., 1., line (-3.), line (1.) } };
+        CHECK(t.done ());
+        CHECK(t.result () == 1.);
+    }
+    SUBCASE("Many solves, evaluated in batches")
+    {
+            auto
+        solvers = std::vector <zhang_solver_t <double>> {};
+        for (auto k = 1; k <= 100; ++k)
+        {
+            solvers.emplace_back (0., 10.);
+        }
+            auto
+        pending = std::vector <double> {};
+            auto
+        running = true;
+        while (running)
+        {
+            pending.clear ();
+            for (auto const& s: solvers)
+            {
+                pending.push_back (s.done () ? 0. : s.ask ());
+            }
+            // E.g. on a device, all at once.
+            for (auto& x: pending)
+            {
+                x = at_f (x);
+            }
+            running = false;
+            for (auto i = 0u; i < solvers.size (); ++i)
+            {
+                solvers[i].tell (pending[i]);
+                running = running || !solvers[i].done ();
+            }
+        }
+        for (auto const& s: solvers)
+        {
+            CHECK(s.info ().converged);
+            CHECK(at_f (s.result ()) == doctest::Approx { 0. });
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/bracketing.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+    namespace
+{
+        auto
+    br_f1 = [](double x){ return std::cos (x) - std::pow (x, 3.0); };
+        auto const
+    br_target1 = 0.8654740331016144466206859011862287477929;
+        auto
+    br_f3 = [](double){ throw int {}; return 1.; };
+}
+
+// The same tests for each method.
+#define BRACKETING_TEST_CASE(name, method)                                       \
+TEST_CASE(name)                                                                 \
+{                                                                               \
+    SUBCASE(#method)                                                            \
+    {                                                                           \
+        CHECK(method (br_f1, 0.0, 10.0) == doctest::Approx { br_target1 });     \
+        CHECK(method ([](double x){ return x - 3.; }, 0.0, 10.0)               \
+            == doctest::Approx { 3. });                                         \
+        CHECK(method ([](double x){ return std::exp (x) - 1e3; }, -10.0, 10.0) \
+            == doctest::Approx { std::log (1e3) });                             \
+    }                                                                           \
+    SUBCASE(#method ", throws if no single root between brackets")             \
+    {                                                                           \
+        CHECK_THROWS_AS(                                                        \
+              method (br_f1, 0.0, 0.1)                                          \
+            , zhang_no_single_root_between_brackets_e                           \
+        );                                                                      \
+    }                                                                           \
+    SUBCASE(#method ", user function throws")                                  \
+    {                                                                           \
+        CHECK_THROWS_AS(method (br_f3, 0.0, 0.1), int);                        \
+    }                                                                           \
+    SUBCASE(#method ", with options")                                          \
+    {                                                                           \
+        CHECK_THROWS_AS(                                                        \
+              method (br_f1, 0.0, 10.0, { .max_iter = 1 })                      \
+            , zhang_no_convergence_e                                            \
+        );                                                                      \
+    }                                                                           \
+    SUBCASE(#method ", with custom stopping criterion")                        \
+    {                                                                           \
+            auto                                                                \
+        r = method (br_f1, 0.0, 10.0, { .converged = make_zhang_simple_converged (1e-8) }); \
+        CHECK(r == doctest::Approx { br_target1 });                             \
+    }                                                                           \
+    SUBCASE(#method ", with info (iteration count)")                           \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (br_f1, 0.0, 10.0, {}, info::iterations);     \
+        CHECK(info.converged);                                                  \
+        CHECK(info.iteration_count > 1);                                        \
+    }                                                                           \
+    SUBCASE(#method ", with info convergence does not throw no_convergence_e!") \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (br_f1, 0.0, 10.0, { .max_iter = 3 }, info::convergence); \
+        CHECK(info.convergence.size () == 3);                                   \
+        CHECK(info.converged == false);                                         \
+    }                                                                           \
+    SUBCASE(#method ", with info, never throw")                                \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (br_f1, 0.0, 0.1, {}, info::iterations);      \
+        CHECK(!info.converged);                                                 \
+        CHECK(info.no_single_root_between_bracket);                             \
+            auto const                                                          \
+        [ result2, info2 ] = method (br_f3, 0.0, 0.1, {}, info::iterations);    \
+        CHECK(!info2.converged);                                                \
+        CHECK(info2.function_threw);                                            \
+    }                                                                           \
+}
+
+BRACKETING_TEST_CASE("ITP", itp)
+BRACKETING_TEST_CASE("Chandrupatla", chandrupatla)
+BRACKETING_TEST_CASE("TOMS 748", toms748)
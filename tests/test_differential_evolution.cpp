@@ -0,0 +1,99 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/differential_evolution.hpp"
+    using namespace calculisto::root_finding;
+#include <atomic>
+#include <cmath>
+#include <numbers>
+
+    namespace
+{
+    // Many local minima, the global one at 0.
+        auto
+    de_rastrigin = [](auto const& x)
+    {
+            auto
+        r = 10. * static_cast <double> (x.size ());
+        for (auto k = 0u; k < x.size (); ++k)
+        {
+            r += x[k] * x[k] - 10. * std::cos (2 * std::numbers::pi * x[k]);
+        }
+        return r;
+    };
+        auto const
+    de_lower = std::array { -5.12, -5.12 };
+        auto const
+    de_upper = std::array {  5.12,  5.12 };
+}
+
+TEST_CASE("Differential evolution")
+{
+    SUBCASE("differential_evolution, std::array")
+    {
+            auto const
+        r = differential_evolution (de_rastrigin, de_lower, de_upper, { .tolerance = 1e-12, .threads = 4 });
+        CHECK(r[0] == doctest::Approx { 0. }.epsilon (1e-5));
+        CHECK(r[1] == doctest::Approx { 0. }.epsilon (1e-5));
+    }
+    SUBCASE("differential_evolution, std::valarray")
+    {
+            auto const
+        r = differential_evolution (de_rastrigin, std::valarray { -5.12, -5.12, -5.12 }, std::valarray { 5.12, 5.12, 5.12 }, { .tolerance = 1e-12 });
+        for (auto x: r)
+        {
+            CHECK(x == doctest::Approx { 0. }.epsilon (1e-5));
+        }
+    }
+    SUBCASE("differential_evolution, one call per generation")
+    {
+            auto
+        calls = 0;
+            auto
+        batch = [&](std::span <std::array <double, 2> const> points)
+        {
+            ++calls;
+                auto
+            r = std::vector <double> {};
+            for (auto const& p: points)
+            {
+                r.push_back (de_rastrigin (p));
+            }
+            return r;
+        };
+            auto const
+        [ r, info ] = differential_evolution (batch, de_lower, de_upper, { .tolerance = 1e-12 }, info::convergence);
+        CHECK(info.converged);
+        CHECK(r[0] == doctest::Approx { 0. }.epsilon (1e-5));
+        CHECK(calls == info.iteration_count + 1);
+        CHECK(info.evaluation_count == 20 * calls);
+        CHECK(info.convergence.size () == static_cast <std::size_t> (info.iteration_count + 1));
+        for (auto i = 1u; i < info.convergence.size (); ++i)
+        {
+            CHECK(std::get <1> (info.convergence[i]) <= std::get <1> (info.convergence[i - 1]));
+        }
+        // Same seed, same result.
+            auto const
+        [ s, s_info ] = differential_evolution (de_rastrigin, de_lower, de_upper, { .tolerance = 1e-12, .threads = 3 }, info::iterations);
+        CHECK(s == r);
+        CHECK(s_info.iteration_count == info.iteration_count);
+    }
+    SUBCASE("differential_evolution, polished by powell")
+    {
+            auto const
+        [ r, info ] = differential_evolution (de_rastrigin, de_lower, de_upper, { .tolerance = 1e-3, .polish = true }, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.polished);
+        CHECK(std::abs (r[0]) < 1e-7);
+        CHECK(std::abs (r[1]) < 1e-7);
+    }
+    SUBCASE("differential_evolution, throws")
+    {
+        CHECK_THROWS_AS(differential_evolution (de_rastrigin, de_lower, de_upper, { .max_iter = 3 }), differential_evolution_no_convergence_e);
+            auto
+        throws = [](std::array <double, 2> const&) -> double { throw 0; };
+        CHECK_THROWS_AS(differential_evolution (throws, de_lower, de_upper), int);
+            auto const
+        [ r, info ] = differential_evolution (throws, de_lower, de_upper, {}, info::iterations);
+        CHECK(info.function_threw);
+        CHECK(!info.converged);
+    }
+}
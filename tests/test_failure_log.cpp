@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/failure_log.hpp"
+#include "../include/calculisto/root_finding/nelder_mead.hpp"
+    using namespace calculisto::root_finding;
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <valarray>
+
+    namespace
+{
+    // A family of problems: cos (x) - p x^3.
+        auto
+    fl_f (double p)
+    {
+        return [=](double x){ return std::cos (x) - p * x * x * x; };
+    }
+}
+
+TEST_CASE("Failure log")
+{
+        const auto
+    path = (std::filesystem::temp_directory_path () / "test_failure_log.bin").string ();
+    SUBCASE("Record and replay")
+    {
+        std::filesystem::remove (path);
+        {
+                auto
+            recorder = failure_recorder_t { path };
+            for (auto p: { 1., 2., 3. })
+            {
+                    const auto
+                inputs = std::array { p, 0., 10. };
+                    auto const
+                [ r, info ] = zhang (fl_f (p), 0., 10., { .max_iter = p == 2. ? 100 : 3 }, info::convergence);
+                CHECK(recorder.record ("zhang", inputs, info) == !info.converged);
+            }
+                auto const
+            [ r, info ] = newton (fl_f (1.), [](double){ return 0.; }, 1., {}, info::convergence);
+            CHECK(recorder.record ("newton", std::array { 1., 1. }, info));
+            CHECK(recorder.dropped () == 0);
+        }
+            const auto
+        log = mapped_failure_log_t { path };
+            auto const&
+        records = log.records ();
+        REQUIRE(records.size () == 3);
+        CHECK(records[0].solver == "zhang");
+        CHECK(records[0].inputs[0] == 1.);
+        CHECK(records[0].rows == 3);
+        CHECK(records[0].columns == 4);
+        CHECK(records[1].inputs[0] == 3.);
+        CHECK(records[2].solver == "newton");
+        CHECK(records[2].rows == 0);
+        // The history is the one of the solve.
+            auto const
+        [ r, info ] = zhang (fl_f (1.), 0., 10., { .max_iter = 3 }, info::convergence);
+        CHECK(records[0].row (2)[0] == std::get <0> (info.convergence[2]));
+        CHECK(records[0].row (2)[3] == std::get <3> (info.convergence[2]));
+        // Replayed with another solver.
+            const auto
+        replays = replay_failures (log, [](failure_record_t const& record)
+        {
+            if (record.solver != "zhang")
+            {
+                return 0.;
+            }
+            return zhang (fl_f (record.inputs[0]), record.inputs[1], record.inputs[2]);
+        });
+        REQUIRE(replays.size () == 3);
+        CHECK(fl_f (3.) (replays[1].result) == doctest::Approx { 0. });
+    }
+    SUBCASE("Record powell")
+    {
+        std::filesystem::remove (path);
+            auto
+        rosenbrock = [](std::valarray <double> const& x)
+        {
+            return std::pow (1. - x[0], 2.) + 100. * std::pow (x[1] - x[0] * x[0], 2.);
+        };
+            auto const
+        [ r, info ] = powell (rosenbrock, std::valarray { -1.2, 1. }, { .max_iter = 2 }, info::convergence);
+        REQUIRE(!info.converged);
+        REQUIRE(info.size () > 0);
+        {
+                auto
+            recorder = failure_recorder_t { path };
+            CHECK(recorder.record ("powell", std::array { -1.2, 1. }, info));
+        }
+            const auto
+        log = mapped_failure_log_t { path };
+            auto const&
+        record = log.records ().at (0);
+        CHECK(record.solver == "powell");
+        CHECK(record.rows == info.size ());
+        CHECK(record.columns == 5);
+        for (auto i = 0u; i < record.rows; ++i)
+        {
+            CHECK(record.row (i)[0] == info.iteration[i]);
+            CHECK(record.row (i)[1] == info.direction[i]);
+            CHECK(record.row (i)[2] == info.f[i]);
+            CHECK(record.row (i)[3] == info.point (i)[0]);
+            CHECK(record.row (i)[4] == info.point (i)[1]);
+        }
+    }
+    SUBCASE("Record a history with points")
+    {
+        std::filesystem::remove (path);
+            auto
+        q = [](auto const& x){ return (x[0] - 1) * (x[0] - 1) + 2 * (x[1] + 0.5) * (x[1] + 0.5); };
+            auto const
+        [ r, info ] = nelder_mead (q, std::array { 0., 0. }, { .max_iter = 5 }, info::convergence);
+        REQUIRE(!info.converged);
+        REQUIRE(info.convergence.size () > 0);
+        {
+                auto
+            recorder = failure_recorder_t { path };
+            CHECK(recorder.record ("nelder_mead", std::array { 0., 0. }, info));
+        }
+            const auto
+        log = mapped_failure_log_t { path };
+            auto const&
+        record = log.records ().at (0);
+        CHECK(record.rows == info.convergence.size ());
+        // Iteration, step, f, and the 2 coordinates of the point.
+        CHECK(record.columns == 5);
+        for (auto i = 0u; i < record.rows; ++i)
+        {
+                auto const&
+            [ iteration, step, f, x ] = info.convergence[i];
+            CHECK(record.row (i)[0] == iteration);
+            CHECK(record.row (i)[1] == static_cast <int> (step));
+            CHECK(record.row (i)[2] == f);
+            CHECK(record.row (i)[3] == x[0]);
+            CHECK(record.row (i)[4] == x[1]);
+        }
+    }
+    SUBCASE("Size cap")
+    {
+        std::filesystem::remove (path);
+            auto
+        recorder = failure_recorder_t { path, { .max_bytes = 200 } };
+            auto const
+        [ r, info ] = zhang (fl_f (1.), 0., 10., { .max_iter = 3 }, info::convergence);
+        CHECK(recorder.record ("zhang", std::array { 1. }, info));
+        CHECK(!recorder.record ("zhang", std::array { 1. }, info));
+        CHECK(recorder.dropped () == 1);
+        CHECK(std::filesystem::file_size (path) <= 200);
+    }
+    SUBCASE("Bad files")
+    {
+        std::filesystem::remove (path);
+        CHECK_THROWS_AS(mapped_failure_log_t { path }, failure_log_bad_file_e);
+        {
+                auto
+            out = std::ofstream { path };
+            out << "not a log";
+        }
+        CHECK_THROWS_AS(mapped_failure_log_t { path }, failure_log_bad_file_e);
+        // A header whose sizes overflow to a small count.
+        std::filesystem::remove (path);
+        {
+                auto
+            recorder = failure_recorder_t { path };
+            recorder.record ("zhang", std::array { 1., 2. }, info::data::base_t { false, false });
+        }
+        {
+                auto
+            file = std::fstream { path, std::ios::binary | std::ios::in | std::ios::out };
+            file.seekp (8 + 16);
+                const std::uint64_t
+            sizes[] = { 2, std::uint64_t { 1 } << 63, 2 };
+            file.write (reinterpret_cast <char const*> (sizes), sizeof sizes);
+        }
+        CHECK_THROWS_AS(mapped_failure_log_t { path }, failure_log_bad_file_e);
+    }
+    std::filesystem::remove (path);
+}
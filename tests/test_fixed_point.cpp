@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/fixed_point.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+#include <array>
+
+    namespace
+{
+        auto
+    fp_cos = [](double x){ return std::cos (x); };
+        auto const
+    fp_target = 0.7390851332151606416553120876738734040134;
+    // A contraction of the plane, with a fixed point at (x, y) such that
+    // x = cos (y) / 2, y = sin (x) / 2 + 0.3.
+        auto
+    fp_g = [](std::array <double, 2> const& p)
+    {
+        return std::array { std::cos (p[1]) / 2, std::sin (p[0]) / 2 + 0.3 };
+    };
+}
+
+TEST_CASE("Fixed point")
+{
+    SUBCASE("fixed_point, scalar (Aitken)")
+    {
+            auto const
+        [ r, info ] = fixed_point (fp_cos, 1., {}, info::iterations);
+        CHECK(r == doctest::Approx { fp_target });
+        CHECK(info.converged);
+        CHECK(info.evaluation_count < 20);
+    }
+    SUBCASE("fixed_point, point (Anderson)")
+    {
+            auto const
+        [ r, info ] = fixed_point (fp_g, std::array { 0., 0. }, {}, info::iterations);
+        CHECK(r[0] == doctest::Approx { std::cos (r[1]) / 2 });
+        CHECK(r[1] == doctest::Approx { std::sin (r[0]) / 2 + 0.3 });
+            auto const
+        [ s, plain ] = fixed_point (fp_g, std::array { 0., 0. }, { .history = 0 }, info::iterations);
+        CHECK(s[0] == doctest::Approx { r[0] });
+        CHECK(s[1] == doctest::Approx { r[1] });
+        CHECK(info.evaluation_count < plain.evaluation_count);
+    }
+    SUBCASE("fixed_point, point, damped")
+    {
+            auto
+        r = fixed_point (fp_g, std::array { 0., 0. }, { .mixing = 0.5 });
+        CHECK(r[0] == doctest::Approx { std::cos (r[1]) / 2 });
+    }
+    SUBCASE("fixed_point, with options")
+    {
+        CHECK_THROWS_AS(
+              fixed_point (fp_cos, 1., { .max_iter = 1 })
+            , fixed_point_no_convergence_e
+        );
+    }
+    SUBCASE("fixed_point, user function throws")
+    {
+            auto
+        f = [](std::array <double, 2> const&) -> std::array <double, 2> { throw int {}; };
+        CHECK_THROWS_AS(fixed_point (f, std::array { 0., 0. }), int);
+            auto const
+        [ r, info ] = fixed_point (f, std::array { 0., 0. }, {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.function_threw);
+    }
+    SUBCASE("fixed_point, with info convergence does not throw no_convergence_e!")
+    {
+            auto const
+        [ r, info ] = fixed_point (fp_g, std::array { 0., 0. }, { .max_iter = 3 }, info::convergence);
+        CHECK(info.convergence.size () == 3);
+        CHECK(!info.converged);
+    }
+}
@@ -0,0 +1,69 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/inverse.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+#include <filesystem>
+
+    namespace
+{
+    // Something like an enthalpy as a function of the temperature.
+        auto
+    iv_h = [](double t){ return 1000. * t + 0.5 * t * t + 1e-4 * t * t * t; };
+        auto
+    iv_dh = [](double t){ return 1000. + t + 3e-4 * t * t; };
+}
+
+TEST_CASE("Inverse")
+{
+        auto
+    table = make_inverse_table (iv_h, 200., 2000.);
+    SUBCASE("make_inverse_table")
+    {
+        for (auto t: { 200., 273.15, 1000., 1234.5, 2000. })
+        {
+            CHECK(table (iv_h (t)) == doctest::Approx { t }.epsilon (1e-10));
+        }
+    }
+    SUBCASE("make_inverse_table, not monotone")
+    {
+        CHECK_THROWS_AS(
+              make_inverse_table ([](double x){ return x * x; }, -1., 1.)
+            , inverse_not_monotone_e
+        );
+        // Increasing from one end to the other, but not in between.
+        CHECK_THROWS_AS(
+              make_inverse_table ([](double x){ return x * x * x - x; }, -2., 2.)
+            , inverse_not_monotone_e
+        );
+        // Decreasing is fine.
+            const auto
+        decreasing = make_inverse_table ([](double x){ return -iv_h (x); }, 200., 2000.);
+        CHECK(decreasing (-iv_h (1234.5)) == doctest::Approx { 1234.5 }.epsilon (1e-10));
+    }
+    SUBCASE("newton_inverse")
+    {
+            auto const
+        [ t, info ] = newton_inverse (iv_h, iv_dh, table, iv_h (1234.5), {}, info::iterations);
+        CHECK(t == doctest::Approx { 1234.5 });
+        CHECK(info.converged);
+        CHECK(info.iteration_count <= 1);
+    }
+    SUBCASE("mapped_inverse_table_t")
+    {
+            const auto
+        path = (std::filesystem::temp_directory_path () / "test_inverse.bin").string ();
+        table.save (path);
+        {
+                auto const
+            mapped = mapped_inverse_table_t <double> { path };
+            for (auto t: { 200., 273.15, 1000., 1234.5, 2000. })
+            {
+                CHECK(mapped (iv_h (t)) == table (iv_h (t)));
+            }
+            CHECK(newton_inverse (iv_h, iv_dh, mapped, iv_h (500.)) == doctest::Approx { 500. });
+            CHECK_THROWS_AS(mapped_inverse_table_t <float> { path }, inverse_bad_file_e);
+        }
+        std::filesystem::remove (path);
+        CHECK_THROWS_AS(mapped_inverse_table_t <double> { path }, inverse_bad_file_e);
+    }
+}
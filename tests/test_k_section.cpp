@@ -0,0 +1,118 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/k_section.hpp"
+    using namespace calculisto::root_finding;
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <set>
+#include <thread>
+
+    namespace
+{
+        auto
+    ks_f = [](double x){ return std::cos (x) - x * x * x; };
+        auto const
+    ks_target = 0.8654740331016144466206859011862287477929;
+}
+
+TEST_CASE("K-section")
+{
+    SUBCASE("k_section")
+    {
+            auto
+        count = std::atomic <int> { 0 };
+            auto
+        f = [&](double x){ ++count; return ks_f (x); };
+            auto const
+        [ r, info ] = k_section (f, 0., 10., { .points = 7, .threads = 4 }, info::convergence);
+        CHECK(r == doctest::Approx { ks_target }.epsilon (1e-15));
+        CHECK(info.converged);
+        CHECK(info.evaluation_count + 2 * info.zhang_info.iteration_count + 2 >= count);
+        CHECK(info.iteration_count == static_cast <int> (info.convergence.size ()));
+        // Each round shrinks the bracket 8 times.
+        for (auto i = 1u; i < info.convergence.size (); ++i)
+        {
+                const auto
+            [ a0, b0, fa0, fb0 ] = info.convergence[i - 1];
+                const auto
+            [ a1, b1, fa1, fb1 ] = info.convergence[i];
+            CHECK((b1 - a1) == doctest::Approx { (b0 - a0) / 8 });
+        }
+        CHECK(k_section (ks_f, 10., 0.) == doctest::Approx { ks_target }.epsilon (1e-15));
+    }
+    SUBCASE("k_section, without zhang")
+    {
+            auto const
+        [ r, info ] = k_section (ks_f, 0., 10., { .points = 3, .linearity = 0 }, info::iterations);
+        CHECK(r == doctest::Approx { ks_target }.epsilon (1e-15));
+        CHECK(info.converged);
+        CHECK(info.zhang_info.iteration_count == 0);
+        CHECK(info.iteration_count > 20);
+    }
+    SUBCASE("k_section, throws")
+    {
+        CHECK_THROWS_AS(k_section (ks_f, 0., 0.1), k_section_no_single_root_between_brackets_e);
+        CHECK_THROWS_AS(k_section (ks_f, 0., 10., { .max_iter = 1, .linearity = 0 }), k_section_no_convergence_e);
+        CHECK_THROWS_AS(k_section ([](double) -> double { throw 0; }, 0., 10.), int);
+            auto const
+        [ r, info ] = k_section ([](double) -> double { throw 0; }, 0., 10., {}, info::iterations);
+        CHECK(info.function_threw);
+        CHECK(!info.converged);
+    }
+    SUBCASE("k_section, shared pool")
+    {
+            auto
+        pool = thread_pool_t { 4 };
+            std::mutex
+        mutex;
+            auto
+        ids = std::set <std::thread::id> {};
+            auto
+        record = [&]
+        {
+                std::scoped_lock
+            lock { mutex };
+            ids.insert (std::this_thread::get_id ());
+        };
+            auto
+        f = [&](double x){ record (); return ks_f (x); };
+            auto
+        g = [&](double x){ record (); return (x - 2.) * (x - 2.) + 1.; };
+        // The same workers, round after round and call after call.
+        for (auto i = 0; i < 3; ++i)
+        {
+            CHECK(k_section (f, 0., 10., { .points = 7, .pool = &pool }) == doctest::Approx { ks_target }.epsilon (1e-15));
+            CHECK(k_section_minimum (g, 0., 5., { .points = 7, .pool = &pool }) == doctest::Approx { 2. }.epsilon (1e-6));
+        }
+        CHECK(ids.size () <= pool.size ());
+        CHECK_THROWS_AS(k_section ([](double) -> double { throw 0; }, 0., 10., { .pool = &pool }), int);
+        CHECK(k_section (ks_f, 0., 10., { .pool = &pool }) == doctest::Approx { ks_target }.epsilon (1e-15));
+    }
+    SUBCASE("k_section_minimum")
+    {
+            auto
+        f = [](double x){ return (x - 2.) * (x - 2.) + 1.; };
+            auto const
+        [ r, info ] = k_section_minimum (f, 0., 5., { .points = 7, .golden_section_options = { .tolerance = 1e-9 } }, info::convergence);
+        CHECK(r == doctest::Approx { 2. }.epsilon (1e-8));
+        CHECK(info.converged);
+        CHECK(info.iteration_count == static_cast <int> (info.convergence.size ()));
+        for (auto const& [ a, b ]: info.convergence)
+        {
+            CHECK(a <= 2.);
+            CHECK(b >= 2.);
+        }
+        CHECK(info.golden_section_info.iteration_count <= 8);
+        CHECK(k_section_minimum (f, 5., 0.) == doctest::Approx { 2. }.epsilon (1e-6));
+    }
+    SUBCASE("k_section_minimum, throws")
+    {
+        CHECK_THROWS_AS(
+              k_section_minimum ([](double x){ return x * x; }, -1., 3., { .max_iter = 1 })
+            , k_section_minimum_no_convergence_e
+        );
+            auto const
+        [ r, info ] = k_section_minimum ([](double) -> double { throw 0; }, 0., 1., {}, info::iterations);
+        CHECK(info.function_threw);
+    }
+}
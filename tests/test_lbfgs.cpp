@@ -0,0 +1,99 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/lbfgs.hpp"
+    using namespace calculisto::root_finding;
+
+// Extended Rosenbrock, with its gradient.
+    auto
+lb_rosenbrock = [](auto const& x)
+{
+        auto
+    f = 0.;
+    for (auto i = 0u; i + 1 < x.size (); i += 2)
+    {
+        f += 100. * std::pow (x[i + 1] - x[i] * x[i], 2.) + std::pow (1. - x[i], 2.);
+    }
+    return f;
+};
+    auto
+lb_rosenbrock_fused = [](auto const& x, auto& g)
+{
+    for (auto i = 0u; i + 1 < x.size (); i += 2)
+    {
+            const auto
+        t = x[i + 1] - x[i] * x[i];
+        g[i]     = -400. * x[i] * t - 2. * (1. - x[i]);
+        g[i + 1] = 200. * t;
+    }
+    return lb_rosenbrock (x);
+};
+    auto
+lb_throws = [](auto const&){ throw int {}; return 1.; };
+
+TEST_CASE("L-BFGS")
+{
+    SUBCASE("lbfgs, fused value and gradient")
+    {
+            auto
+        init = std::valarray <double> (100);
+        for (auto i = 0u; i < init.size (); i += 2)
+        {
+            init[i]     = -1.2;
+            init[i + 1] = 1.;
+        }
+            auto
+        r = lbfgs (lb_rosenbrock_fused, init);
+        for (auto v: r)
+        {
+            CHECK(v == doctest::Approx { 1. });
+        }
+    }
+    SUBCASE("lbfgs, finite differences gradient, std::array")
+    {
+            auto
+        r = lbfgs (lb_rosenbrock, std::array { -1.2, 1., -1.2, 1. }, { .gradient_tolerance = 1e-6 });
+        for (auto v: r)
+        {
+            CHECK(v == doctest::Approx { 1. }.epsilon (1e-4));
+        }
+    }
+    SUBCASE("lbfgs, user function throws")
+    {
+        CHECK_THROWS_AS(
+              lbfgs (lb_throws, std::array { 0., 0. })
+            , int
+        );
+    }
+    SUBCASE("lbfgs, with options")
+    {
+        CHECK_THROWS_AS(
+              lbfgs (lb_rosenbrock_fused, std::array { -1.2, 1. }, { .max_iter = 2 })
+            , lbfgs_no_convergence_e
+        );
+    }
+    SUBCASE("lbfgs, with info (iteration count)")
+    {
+            auto const
+        [ result, info ] = lbfgs (lb_rosenbrock_fused, std::array { -1.2, 1. }, { .history = 5 }, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.iteration_count > 1);
+        CHECK(info.evaluation_count >= info.iteration_count);
+    }
+    SUBCASE("lbfgs, with info (convergence)")
+    {
+            auto const
+        [ result, info ] = lbfgs (lb_rosenbrock_fused, std::valarray { -1.2, 1. }, {}, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.convergence.size () > 1);
+        for (auto&& [ i, f, g, p ]: info.convergence)
+        {
+            MESSAGE("iter: ", i, ", f= ", f, ", |g|= ", g, ", p= ", p);
+        }
+    }
+    SUBCASE("lbfgs, user function throws, with info")
+    {
+            auto const
+        [ result, info ] = lbfgs (lb_throws, std::array { 0., 0. }, {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.function_threw);
+    }
+}
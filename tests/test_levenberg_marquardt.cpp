@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/levenberg_marquardt.hpp"
+    using namespace calculisto::root_finding;
+
+// Fit y = a exp (-b t) + c.
+    constexpr auto
+lm_m = 20u;
+    auto
+lm_model = [](auto const& p, double t){ return p[0] * std::exp (-p[1] * t) + p[2]; };
+    auto
+lm_data = []
+{
+        std::array <std::pair <double, double>, lm_m>
+    d;
+    for (auto i = 0u; i < lm_m; ++i)
+    {
+            const auto
+        t = 0.25 * i;
+        d[i] = { t, lm_model (std::array { 2.5, 1.3, 0.5 }, t) };
+    }
+    return d;
+} ();
+    auto
+lm_residuals = [](auto const& p, auto& r)
+{
+    for (auto i = 0u; i < lm_m; ++i)
+    {
+        r[i] = lm_model (p, lm_data[i].first) - lm_data[i].second;
+    }
+};
+    auto
+lm_jacobian = [](auto const& p, auto& J)
+{
+    for (auto i = 0u; i < lm_m; ++i)
+    {
+            const auto
+        t = lm_data[i].first;
+            const auto
+        e = std::exp (-p[1] * t);
+        J[i * 3 + 0] = e;
+        J[i * 3 + 1] = -p[0] * t * e;
+        J[i * 3 + 2] = 1.;
+    }
+};
+    auto
+lm_throws = [](auto const&, auto&){ throw int {}; };
+
+TEST_CASE("Levenberg-Marquardt")
+{
+    SUBCASE("levenberg_marquardt, finite differences")
+    {
+            auto
+        r = levenberg_marquardt (lm_residuals, std::array { 1., 1., 0. }, lm_m);
+        CHECK(r[0] == doctest::Approx { 2.5 });
+        CHECK(r[1] == doctest::Approx { 1.3 });
+        CHECK(r[2] == doctest::Approx { 0.5 });
+    }
+    SUBCASE("levenberg_marquardt, with Jacobian")
+    {
+            auto
+        r = levenberg_marquardt (lm_residuals, lm_jacobian, std::valarray { 1., 1., 0. }, lm_m);
+        CHECK(r[0] == doctest::Approx { 2.5 });
+        CHECK(r[1] == doctest::Approx { 1.3 });
+        CHECK(r[2] == doctest::Approx { 0.5 });
+    }
+    SUBCASE("levenberg_marquardt, reusing a workspace")
+    {
+            auto
+        w = levenberg_marquardt_workspace_t <double> {};
+        for (auto guess: { 0.5, 1., 2. })
+        {
+                auto
+            r = levenberg_marquardt (lm_residuals, lm_jacobian, std::array { 1., guess, 0. }, lm_m, { .workspace = &w });
+            CHECK(r[1] == doctest::Approx { 1.3 });
+        }
+        CHECK(w.r.size () == lm_m);
+    }
+    SUBCASE("levenberg_marquardt, user function throws")
+    {
+        CHECK_THROWS_AS(
+              levenberg_marquardt (lm_throws, std::array { 0., 0. }, 3)
+            , int
+        );
+    }
+    SUBCASE("levenberg_marquardt, with options")
+    {
+        CHECK_THROWS_AS(
+              levenberg_marquardt (lm_residuals, std::array { 1., 1., 0. }, lm_m, { .max_iter = 1 })
+            , levenberg_marquardt_no_convergence_e
+        );
+    }
+    SUBCASE("levenberg_marquardt, with info (iteration count)")
+    {
+            auto const
+        [ result, info ] = levenberg_marquardt (lm_residuals, lm_jacobian, std::array { 1., 1., 0. }, lm_m, {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.iteration_count > 1);
+        CHECK(info.jacobian_count == info.iteration_count + 1);
+        MESSAGE("evaluations: ", info.evaluation_count);
+    }
+    SUBCASE("levenberg_marquardt, with info (convergence)")
+    {
+            auto const
+        [ result, info ] = levenberg_marquardt (lm_residuals, std::valarray { 1., 1., 0. }, lm_m, {}, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.convergence.size () > 1);
+        for (auto&& [ i, cost, lambda, p ]: info.convergence)
+        {
+            MESSAGE("iter: ", i, ", cost= ", cost, ", lambda= ", lambda, ", p= ", p);
+        }
+    }
+    SUBCASE("levenberg_marquardt, user Jacobian throws, with info")
+    {
+            auto const
+        [ result, info ] = levenberg_marquardt (lm_residuals, lm_throws, std::array { 1., 1., 0. }, lm_m, {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.jacobian_threw);
+    }
+}
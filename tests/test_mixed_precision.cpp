@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/mixed_precision.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+    namespace
+{
+        auto
+    mp_f = [](auto x){ using std::cos; return cos (x) - x * x * x; };
+        auto
+    mp_df = [](auto x){ using std::sin; return -sin (x) - 3 * x * x; };
+        auto const
+    mp_target = 0.8654740331016144466206859011862287477929L;
+}
+
+TEST_CASE("Mixed precision")
+{
+    SUBCASE("newton_mixed")
+    {
+            auto const
+        [ r, info ] = newton_mixed (mp_f, mp_df, 1.0, {}, info::iterations);
+        CHECK(r == doctest::Approx { static_cast <double> (mp_target) }.epsilon (1e-15));
+        CHECK(info.converged);
+        CHECK(info.low_info.converged);
+        CHECK(info.high_info.iteration_count < 3);
+            auto
+        s = newton_mixed (mp_f, mp_df, 1.0L);
+        CHECK(std::fabs (s - mp_target) < 1e-18L);
+    }
+    SUBCASE("newton_mixed, throws")
+    {
+        CHECK_THROWS_AS(
+              newton_mixed (mp_f, [](auto){ return 0.0; }, 1.0)
+            , newton_zero_derivative_e
+        );
+        CHECK_THROWS_AS(
+              newton_mixed ([](auto x) -> decltype (x) { throw int {}; }, mp_df, 1.0)
+            , int
+        );
+    }
+    SUBCASE("newton_mixed, with info (convergence)")
+    {
+            auto const
+        [ r, info ] = newton_mixed (mp_f, mp_df, 1.0, {}, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.low_info.convergence.size () > info.high_info.convergence.size ());
+    }
+    SUBCASE("zhang_mixed")
+    {
+            auto const
+        [ r, info ] = zhang_mixed (mp_f, 0.0, 10.0, {}, info::iterations);
+        CHECK(r == doctest::Approx { static_cast <double> (mp_target) }.epsilon (1e-15));
+        CHECK(info.converged);
+        CHECK(info.low_info.converged);
+        CHECK(info.high_info.iteration_count < 3);
+            auto
+        s = zhang_mixed (mp_f, 0.0L, 10.0L);
+        CHECK(std::fabs (s - mp_target) < 1e-18L);
+    }
+    SUBCASE("zhang_mixed, throws")
+    {
+        CHECK_THROWS_AS(
+              zhang_mixed (mp_f, 0.0, 0.1)
+            , zhang_no_single_root_between_brackets_e
+        );
+            auto const
+        [ r, info ] = zhang_mixed (mp_f, 0.0, 0.1, {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.high_info.no_single_root_between_bracket);
+    }
+}
@@ -0,0 +1,95 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/multiple_roots.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+    namespace
+{
+    // A triple root at 1, in a factored form.
+        auto
+    mr_f3 = [](double x){ return std::pow (x - 1, 3) * std::exp (x); };
+        auto
+    mr_df3 = [](double x){ return std::pow (x - 1, 2) * (x + 2) * std::exp (x); };
+    // A double root at 2, and a simple one at -1.
+        auto
+    mr_f2 = [](double x){ return (x - 2) * (x - 2) * (x + 1); };
+        auto
+    mr_df2 = [](double x){ return 2 * (x - 2) * (x + 1) + (x - 2) * (x - 2); };
+    // The same, expanded: noisy near the double root.
+        auto
+    mr_p2 = [](double x){ return ((x - 3) * x + 0) * x + 4; };
+        auto
+    mr_dp2 = [](double x){ return (3 * x - 6) * x; };
+        auto
+    mr_f1 = [](double x){ return std::cos (x) - std::pow (x, 3.0); };
+        auto
+    mr_df1 = [](double x){ return -std::sin (x) - 3 * std::pow (x, 2.0); };
+        auto const
+    mr_target1 = 0.8654740331016144466206859011862287477929;
+}
+
+TEST_CASE("Multiple roots")
+{
+    SUBCASE("newton_multiple, triple root")
+    {
+            auto const
+        [ r, info ] = newton_multiple (mr_f3, mr_df3, 3., {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.multiplicity == 3);
+        CHECK(r == doctest::Approx { 1. }.epsilon (1e-14));
+            auto const
+        [ s, newton_info ] = newton (mr_f3, mr_df3, 3., { .max_iter = 1000, .converged = make_newton_simple_converged (1e-12) }, info::iterations);
+        CHECK(newton_info.converged);
+        CHECK(info.iteration_count * 3 < newton_info.iteration_count);
+    }
+    SUBCASE("newton_multiple, double root")
+    {
+            auto const
+        [ r, info ] = newton_multiple (mr_f2, mr_df2, 5., {}, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.multiplicity == 2);
+        CHECK(r == doctest::Approx { 2. }.epsilon (1e-14));
+        CHECK(info.multiplicities.size () == info.convergence.size ());
+        CHECK(info.multiplicities.front () == 1);
+        CHECK(info.multiplicities.back () == 2);
+    }
+    SUBCASE("newton_multiple, double root, expanded")
+    {
+            auto const
+        [ r, info ] = newton_multiple (mr_p2, mr_dp2, 5., { .converged = make_newton_simple_converged (1e-7) }, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.multiplicity == 2);
+        CHECK(r == doctest::Approx { 2. }.epsilon (1e-7));
+        CHECK(info.iteration_count < 15);
+    }
+    SUBCASE("newton_multiple, simple roots")
+    {
+            auto const
+        [ r, info ] = newton_multiple (mr_f2, mr_df2, -3., {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.multiplicity == 1);
+        CHECK(r == doctest::Approx { -1. }.epsilon (1e-15));
+        CHECK(newton_multiple (mr_f1, mr_df1, 1.) == doctest::Approx { mr_target1 }.epsilon (1e-15));
+    }
+    SUBCASE("newton_multiple, NaN")
+    {
+        // The multiplicity estimate is then NaN, and left out.
+            auto
+        nan_below = [](double x){ return x < 2.9 ? std::nan ("") : mr_f3 (x); };
+            auto const
+        [ r, info ] = newton_multiple (nan_below, mr_df3, 3., { .max_iter = 10 }, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.multiplicity >= 1);
+        CHECK(info.multiplicity <= 16);
+    }
+    SUBCASE("newton_multiple, throws")
+    {
+        CHECK_THROWS_AS(newton_multiple (mr_f3, mr_df3, 3., { .max_iter = 2 }), newton_no_convergence_e);
+        CHECK_THROWS_AS(newton_multiple ([](double){ return 1.; }, [](double){ return 0.; }, 3.), newton_zero_derivative_e);
+        CHECK_THROWS_AS(newton_multiple ([](double) -> double { throw 0; }, mr_df3, 3.), int);
+            auto const
+        [ r, info ] = newton_multiple (mr_f3, [](double) -> double { throw 0; }, 3., {}, info::iterations);
+        CHECK(info.derivative_threw);
+        CHECK(!info.converged);
+    }
+}
@@ -0,0 +1,109 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/multistart.hpp"
+    using namespace calculisto::root_finding;
+#include <atomic>
+#include <cmath>
+
+    namespace
+{
+    // The six-hump camel function: six minima in [-3, 3] x [-2, 2], two of
+    // them global.
+        auto
+    camel = [](std::valarray <double> const& p)
+    {
+            const auto
+        x = p[0];
+            const auto
+        y = p[1];
+        return (4 - 2.1 * x * x + x * x * x * x / 3) * x * x + x * y + (-4 + 4 * y * y) * y * y;
+    };
+        auto const
+    camel_lower = std::valarray <double> { -3, -2 };
+        auto const
+    camel_upper = std::valarray <double> { 3, 2 };
+}
+
+TEST_CASE("Multistart")
+{
+    SUBCASE("halton")
+    {
+        CHECK(halton <double> (0, 2)[0] == 0.5);
+        CHECK(halton <double> (0, 2)[1] == doctest::Approx { 1. / 3 });
+        CHECK(halton <double> (2, 3)[0] == 0.75);
+        CHECK(halton <double> (2, 3)[1] == doctest::Approx { 1. / 9 });
+        CHECK(halton <double> (2, 3)[2] == doctest::Approx { 3. / 5 });
+    }
+    SUBCASE("multistart")
+    {
+            auto const
+        [ minima, info ] = multistart (camel, camel_lower, camel_upper, { .starts = 64, .threads = 4 }, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.starts.size () == 64);
+        REQUIRE(minima.size () >= 2);
+        CHECK(minima[0].f == doctest::Approx { -1.0316284534898774 });
+        CHECK(minima[1].f == doctest::Approx { -1.0316284534898774 });
+        CHECK(std::abs (minima[0].x[0]) == doctest::Approx { 0.08984201368301331 }.epsilon (1e-6));
+        CHECK(std::abs (minima[0].x[1]) == doctest::Approx { 0.7126564032704135 }.epsilon (1e-6));
+        CHECK(minima[0].x[0] == doctest::Approx { -minima[1].x[0] }.epsilon (1e-6));
+            auto
+        hits = 0;
+        for (auto i = 1u; i < minima.size (); ++i)
+        {
+            CHECK(minima[i - 1].f <= minima[i].f);
+        }
+        for (auto const& m: minima)
+        {
+            hits += m.hits;
+        }
+        CHECK(hits + info.pruned + info.failed == 64);
+        CHECK(info.pruned > 0);
+    }
+    SUBCASE("multistart, without pruning")
+    {
+            auto
+        count = std::atomic <int> { 0 };
+            auto
+        f = [&](std::valarray <double> const& p){ ++count; return camel (p); };
+            auto const
+        [ minima, info ] = multistart (f, camel_lower, camel_upper, { .starts = 32, .basin_radius = 0 }, info::iterations);
+        CHECK(info.pruned == 0);
+        CHECK(minima.size () == 6);
+            auto
+        pruned_count = std::atomic <int> { 0 };
+            auto
+        g = [&](std::valarray <double> const& p){ ++pruned_count; return camel (p); };
+            auto const
+        pruned = multistart (g, camel_lower, camel_upper, { .starts = 32 });
+        CHECK(pruned.size () <= 6);
+        CHECK(pruned_count < count);
+    }
+    SUBCASE("multistart, throws")
+    {
+            auto const
+        [ minima, info ] = multistart ([](std::valarray <double> const&) -> double { throw 0; }, camel_lower, camel_upper, { .starts = 4 }, info::iterations);
+        CHECK(minima.empty ());
+        CHECK(!info.converged);
+        CHECK(info.failed == 4);
+        // Throws at the last evaluation of a single start, after powell.
+            auto
+        count = 0;
+        multistart ([&](std::valarray <double> const& p){ ++count; return camel (p); }, camel_lower, camel_upper, { .starts = 1, .threads = 1 });
+            auto
+        calls = 0;
+            auto const
+        [ last, last_info ] = multistart (
+              [&](std::valarray <double> const& p)
+              {
+                  if (++calls == count) throw 0;
+                  return camel (p);
+              }
+            , camel_lower
+            , camel_upper
+            , { .starts = 1, .threads = 1 }
+            , info::iterations
+        );
+        CHECK(calls == count);
+        CHECK(last.empty ());
+        CHECK(last_info.failed == 1);
+    }
+}
@@ -0,0 +1,130 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/nelder_mead.hpp"
+    using namespace calculisto::root_finding;
+#include <atomic>
+
+    auto
+nm_rosenbrock = [](auto const& x)
+{
+        using std::pow;
+    return pow (1. - x[0], 2.) + 100. * pow (x[1] - pow (x[0], 2.), 2.);
+};
+    auto
+nm_throws = [](auto const&){ throw int {}; return 1.; };
+
+TEST_CASE("Nelder-Mead")
+{
+    SUBCASE("nelder_mead, std::valarray")
+    {
+            auto
+        r = nelder_mead (nm_rosenbrock, std::valarray { 0.1, 0.1 }, { .tolerance = 1e-14, .x_tolerance = 1e-10 });
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 1. });
+    }
+    SUBCASE("nelder_mead, std::array")
+    {
+            auto
+        r = nelder_mead (nm_rosenbrock, std::array { -1.2, 1. }, { .tolerance = 1e-14, .x_tolerance = 1e-10 });
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 1. });
+    }
+    SUBCASE("nelder_mead, classical coefficients")
+    {
+            auto
+        r = nelder_mead (nm_rosenbrock, std::array { -1.2, 1. }, { .tolerance = 1e-14, .x_tolerance = 1e-10, .adaptive = false });
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 1. });
+    }
+    SUBCASE("nelder_mead, adaptive in 1D")
+    {
+            auto
+        f = [](auto const& x){ return std::fabs (x[0] - 2.) + 0.1 * (x[0] - 2.) * (x[0] - 2.); };
+            auto const
+        [ r, info ] = nelder_mead (f, std::array { 0. }, { .adaptive = true }, info::iterations);
+        CHECK(info.converged);
+        CHECK(r[0] == doctest::Approx { 2. });
+        // The classical coefficients.
+            auto const
+        [ r_classical, info_classical ] = nelder_mead (f, std::array { 0. }, { .adaptive = false }, info::iterations);
+        CHECK(r[0] == r_classical[0]);
+        CHECK(info.evaluation_count == info_classical.evaluation_count);
+    }
+    SUBCASE("nelder_mead, non-smooth objective")
+    {
+            auto
+        r = nelder_mead (
+              [](auto const& x){ return std::fabs (x[0] - 1.) + std::fabs (x[1] + 2.) + std::fabs (x[2]); }
+            , std::array { 0., 0., 0. }
+            , { .tolerance = 1e-12, .x_tolerance = 1e-10 }
+        );
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { -2. });
+        CHECK(r[2] == doctest::Approx { 0. }.scale (1e-4));
+    }
+    SUBCASE("nelder_mead, concurrent evaluations")
+    {
+            std::atomic <int>
+        count = 0;
+            auto const
+        [ r, info ] = nelder_mead (
+              [&](auto const& x){ ++count; return nm_rosenbrock (x); }
+            , std::array { -1.2, 1. }
+            , { .tolerance = 1e-14, .x_tolerance = 1e-10, .concurrent = true }
+            , info::iterations
+        );
+        CHECK(info.converged);
+        CHECK(info.evaluation_count == count);
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 1. });
+        // On a pool shared by the calls.
+            auto
+        pool = thread_pool_t { 2 };
+        for (auto k = 0; k < 3; ++k)
+        {
+                auto
+            s = nelder_mead (nm_rosenbrock, std::array { -1.2, 1. }, { .tolerance = 1e-14, .x_tolerance = 1e-10, .concurrent = true, .pool = &pool });
+            CHECK(s[0] == r[0]);
+            CHECK(s[1] == r[1]);
+        }
+    }
+    SUBCASE("nelder_mead, user function throws")
+    {
+        CHECK_THROWS_AS(
+              nelder_mead (nm_throws, std::array { 0., 0. })
+            , int
+        );
+    }
+    SUBCASE("nelder_mead, with options")
+    {
+        CHECK_THROWS_AS(
+              nelder_mead (nm_rosenbrock, std::array { -1.2, 1. }, { .max_iter = 3 })
+            , nelder_mead_no_convergence_e
+        );
+    }
+    SUBCASE("nelder_mead, with info (iteration count)")
+    {
+            auto const
+        [ result, info ] = nelder_mead (nm_rosenbrock, std::array { -1.2, 1. }, { /*default options*/ }, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.iteration_count > 1);
+        CHECK(info.evaluation_count > info.iteration_count);
+    }
+    SUBCASE("nelder_mead, with info (convergence)")
+    {
+            auto const
+        [ result, info ] = nelder_mead (nm_rosenbrock, std::valarray { -1.2, 1. }, { .max_iter = 5 }, info::convergence);
+        CHECK(!info.converged);
+        CHECK(info.convergence.size () == 5);
+        for (auto&& [ i, step, f, p ]: info.convergence)
+        {
+            MESSAGE("iter: ", i, ", step: ", static_cast <int> (step), ", f= ", f, ", p= ", p);
+        }
+    }
+    SUBCASE("nelder_mead, user function throws, with info")
+    {
+            auto const
+        [ result, info ] = nelder_mead (nm_throws, std::array { 0., 0. }, {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.function_threw);
+    }
+}
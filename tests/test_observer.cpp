@@ -0,0 +1,279 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/observer.hpp"
+#include "../include/calculisto/root_finding/bracketing.hpp"
+#include "../include/calculisto/root_finding/open_methods.hpp"
+#include "../include/calculisto/root_finding/nelder_mead.hpp"
+#include "../include/calculisto/root_finding/lbfgs.hpp"
+#include "../include/calculisto/root_finding/levenberg_marquardt.hpp"
+#include "../include/calculisto/root_finding/fixed_point.hpp"
+#include "../include/calculisto/root_finding/polynomial.hpp"
+#include "../include/calculisto/root_finding/all_roots.hpp"
+#include "../include/calculisto/root_finding/k_section.hpp"
+#include "../include/calculisto/root_finding/multistart.hpp"
+#include "../include/calculisto/root_finding/differential_evolution.hpp"
+#include <atomic>
+    using namespace calculisto::root_finding;
+#include <cmath>
+#include <sstream>
+#include <string>
+
+    namespace
+{
+        auto
+    ob_f = [](double x){ return std::cos (x) - x * x * x; };
+        auto
+    ob_df = [](double x){ return -std::sin (x) - 3 * x * x; };
+        auto
+    ob_q = [](auto const& x){ return (x[0] - 1) * (x[0] - 1) + 2 * (x[1] + 0.5) * (x[1] + 0.5); };
+
+        struct
+    counter_t
+    {
+            int
+        events = 0;
+            int
+        bisections = 0;
+            template <class Event>
+            void
+        operator () (Event const& event)
+        {
+            ++events;
+            bisections += event.step == step_t::bisection;
+        }
+    };
+
+        using
+    counter_ref_t = std::reference_wrapper <counter_t>;
+        using
+    zhang_converged_t = zhang_default_converged_t <double, double>;
+        using
+    newton_converged_t = newton_default_converged_t <double, double>;
+}
+
+TEST_CASE("Observer")
+{
+    SUBCASE("The default observer is empty")
+    {
+        CHECK(std::is_empty_v <no_observer_t>);
+            struct
+        without_observer_t
+        {
+                int
+            max_iter;
+                zhang_converged_t
+            converged;
+        };
+        CHECK(sizeof (zhang_static_options_t <double, double>) == sizeof (without_observer_t));
+    }
+    SUBCASE("An event per evaluation")
+    {
+            auto
+        counter = counter_t {};
+            auto
+        evaluations = 0;
+            auto
+        f = [&](double x){ ++evaluations; return ob_f (x); };
+        zhang (f, 0., 10., zhang_options_t <double, double, zhang_converged_t, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        CHECK(counter.bisections > 0);
+        counter = {};
+        evaluations = 0;
+        newton (f, ob_df, 1., newton_options_t <double, double, double, newton_converged_t, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        toms748 (f, 0., 10., toms748_options_t <double, double, zhang_converged_t, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        chandrupatla (f, 0., 10., chandrupatla_options_t <double, double, zhang_converged_t, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        itp (f, 0., 10., itp_options_t <double, double, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        secant (f, 1., secant_options_t <double, double, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        steffensen (f, 1., steffensen_options_t <double, double, std::reference_wrapper <counter_t>> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+    }
+    SUBCASE("An event per evaluation, the other solvers")
+    {
+            auto
+        counter = counter_t {};
+            auto
+        evaluations = std::atomic <int> { 0 };
+            auto
+        f = [&](double x){ ++evaluations; return ob_f (x); };
+            auto
+        q = [&](auto const& x){ ++evaluations; return (x[0] - 1) * (x[0] - 1) + 2 * (x[1] + 0.5) * (x[1] + 0.5); };
+            auto
+        reset = [&]{ counter = {}; evaluations = 0; };
+        bracket_root (f, 5., 1., bracket_root_options_t <counter_ref_t> { .observer = std::ref (counter) });
+        CHECK(counter.events == evaluations);
+        reset ();
+        golden_section ([&](double x){ ++evaluations; return (x - 1) * (x - 1); }, 0., 3., golden_section_options_t <double, counter_ref_t> {
+            .tolerance = 1e-8, .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        reset ();
+        powell (q, std::valarray { 0., 0. }, powell_options_t <double, double, counter_ref_t> { .observer = std::ref (counter) });
+        CHECK(counter.events == evaluations);
+        reset ();
+        nelder_mead (q, std::array { 0., 0. }, nelder_mead_options_t <double, double, counter_ref_t> { .observer = std::ref (counter) });
+        CHECK(counter.events == evaluations);
+        reset ();
+        lbfgs (
+              [&](auto const& x, auto& g){ g[0] = 2 * (x[0] - 1); g[1] = 4 * (x[1] + 0.5); return q (x); }
+            , std::array { 0., 0. }
+            , lbfgs_options_t <double, double, counter_ref_t> { .observer = std::ref (counter) }
+        );
+        CHECK(counter.events == evaluations);
+        reset ();
+        fixed_point ([&](double x){ ++evaluations; return std::cos (x); }, 1., fixed_point_options_t <double, counter_ref_t> {
+            .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        reset ();
+            auto
+        [ roots, roots_info ] = all_roots ([](double x){ return std::sin (x); }, 0., 10., all_roots_options_t <double, double, counter_ref_t> {
+            .samples = 16, .threads = 2, .observer = std::ref (counter)
+        }, info::iterations);
+        CHECK(roots.size () == 4);
+        CHECK(counter.events == roots_info.evaluation_count);
+        reset ();
+        polynomial_roots (std::vector { -6., 11., -6., 1., 1., 1. }, polynomial_options_t <double, counter_ref_t> {
+            .closed_form = false, .observer = std::ref (counter)
+        });
+        CHECK(counter.events >= 5);
+    }
+    SUBCASE("An event per cost, levenberg_marquardt without Jacobian")
+    {
+            auto
+        counter = counter_t {};
+            auto
+        evaluations = 0;
+            auto
+        residuals = [&](auto const& x, auto& r)
+        {
+            ++evaluations;
+            r[0] = x[0] - 1;
+            r[1] = 2 * (x[1] + 0.5);
+            r[2] = (x[0] - 1) * (x[1] + 0.5);
+        };
+            auto const
+        [ x, info ] = levenberg_marquardt (residuals, std::array { 0., 0. }, 3, levenberg_marquardt_options_t <double, counter_ref_t> {
+            .observer = std::ref (counter)
+        }, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.evaluation_count == evaluations);
+        // Not at the 2 finite differences per Jacobian.
+        CHECK(counter.events == evaluations - 2 * (info.iteration_count + 1));
+    }
+    SUBCASE("An event per evaluation, k_section")
+    {
+            auto
+        counter = counter_t {};
+            auto
+        evaluations = std::atomic <int> { 0 };
+        k_section ([&](double x){ ++evaluations; return ob_f (x); }, 0., 10., k_section_options_t <double, double, counter_ref_t> {
+            .points = 3, .threads = 2, .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+        counter = {};
+        evaluations = 0;
+        k_section_minimum ([&](double x){ ++evaluations; return (x - 1) * (x - 1); }, 0., 3., k_section_minimum_options_t <double, counter_ref_t> {
+            .points = 3, .threads = 2, .observer = std::ref (counter)
+        });
+        CHECK(counter.events == evaluations);
+    }
+    SUBCASE("An event per start, multistart")
+    {
+            auto
+        counter = counter_t {};
+            const auto
+        minima = multistart (ob_q, std::valarray { -2., -2. }, std::valarray { 2., 2. }, multistart_options_t <double, double, counter_ref_t> {
+            .starts = 8, .threads = 2, .observer = std::ref (counter)
+        });
+            auto
+        hits = 0;
+        for (auto const& m: minima) hits += m.hits;
+        CHECK(counter.events == hits);
+    }
+    SUBCASE("An event per evaluation, differential_evolution")
+    {
+            auto
+        counter = counter_t {};
+            auto const
+        [ population, info ] = differential_evolution (ob_q, std::array { -2., -2. }, std::array { 2., 2. }, differential_evolution_options_t <double, double, counter_ref_t> {
+            .max_iter = 20, .threads = 2, .observer = std::ref (counter)
+        }, info::iterations);
+        CHECK(counter.events == info.evaluation_count);
+    }
+    SUBCASE("chrome_trace_t")
+    {
+            auto
+        out = std::ostringstream {};
+        {
+                auto
+            trace = chrome_trace_t { out };
+            zhang (ob_f, 0., 10., zhang_options_t <double, double, zhang_converged_t, std::reference_wrapper <chrome_trace_t>> {
+                .observer = std::ref (trace)
+            });
+        }
+            const auto
+        json = out.str ();
+        CHECK(json.front () == '[');
+        CHECK(json.find (R"("name":"zhang")") != std::string::npos);
+        CHECK(json.find (R"("step":"bisection")") != std::string::npos);
+        CHECK(json.find (",\n]") == std::string::npos);
+        CHECK(json.substr (json.size () - 3) == "\n]\n");
+    }
+    SUBCASE("binary_event_log_t")
+    {
+            auto
+        out = std::stringstream {};
+            auto
+        evaluations = 0;
+        {
+                auto
+            log = binary_event_log_t { out };
+            zhang (
+                  [&](double x){ ++evaluations; return ob_f (x); }
+                , 0.
+                , 10.
+                , zhang_options_t <double, double, zhang_converged_t, std::reference_wrapper <binary_event_log_t>> {
+                    .observer = std::ref (log)
+                  }
+            );
+        }
+            const auto
+        records = read_event_log (out);
+        CHECK(records.size () == static_cast <std::size_t> (evaluations));
+        CHECK(std::string { records.front ().solver } == "zhang");
+        CHECK(records.front ().step == static_cast <std::int32_t> (step_t::initial));
+        CHECK(records.front ().x == 0.);
+        CHECK(records.back ().f == doctest::Approx { 0. });
+            auto
+        bad = std::istringstream { "not a log" };
+        CHECK_THROWS_AS(read_event_log (bad), event_log_bad_file_e);
+    }
+}
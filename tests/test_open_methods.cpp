@@ -0,0 +1,80 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/open_methods.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+    namespace
+{
+        auto
+    om_f1 = [](double x){ return std::cos (x) - std::pow (x, 3.0); };
+        auto const
+    om_target1 = 0.8654740331016144466206859011862287477929;
+        auto
+    om_f2 = [](double x){ return std::cos (x) - x; };
+        auto const
+    om_target2 = 0.7390851332151606416553120876738734040134;
+        auto
+    om_f3 = [](double){ throw int {}; return 1.; };
+        auto
+    om_f4 = [](double){ return 1.; };
+}
+
+// The same tests for each method.
+#define OPEN_METHOD_TEST_CASE(name, method)                                      \
+TEST_CASE(name)                                                                 \
+{                                                                               \
+    SUBCASE(#method)                                                            \
+    {                                                                           \
+        CHECK(method (om_f1, 1.0) == doctest::Approx { om_target1 });           \
+        CHECK(method (om_f2, 1.0) == doctest::Approx { om_target2 });           \
+    }                                                                           \
+    SUBCASE(#method ", with custom convergence criterion")                     \
+    {                                                                           \
+            auto                                                                \
+        r = method (om_f1, 1.0, { .converged = make_newton_simple_converged (1e-12) }); \
+        CHECK(r == doctest::Approx { om_target1 });                             \
+    }                                                                           \
+    SUBCASE(#method ", throws if zero slope")                                  \
+    {                                                                           \
+        CHECK_THROWS_AS(method (om_f4, 1.0), newton_zero_derivative_e);        \
+    }                                                                           \
+    SUBCASE(#method ", user function throws")                                  \
+    {                                                                           \
+        CHECK_THROWS_AS(method (om_f3, 1.0), int);                             \
+    }                                                                           \
+    SUBCASE(#method ", with options")                                          \
+    {                                                                           \
+        CHECK_THROWS_AS(                                                        \
+              method (om_f1, 1.0, { .max_iter = 1 })                            \
+            , newton_no_convergence_e                                           \
+        );                                                                      \
+    }                                                                           \
+    SUBCASE(#method ", with info (iteration count)")                           \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (om_f1, 1.0, {}, info::iterations);           \
+        CHECK(info.converged);                                                  \
+        CHECK(info.iteration_count > 1);                                        \
+    }                                                                           \
+    SUBCASE(#method ", with info convergence does not throw no_convergence_e!") \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (om_f1, 1.0, { .max_iter = 3 }, info::convergence); \
+        CHECK(info.convergence.size () == 3);                                   \
+        CHECK(info.converged == false);                                         \
+    }                                                                           \
+    SUBCASE(#method ", with info, never throw")                                \
+    {                                                                           \
+            auto const                                                          \
+        [ result, info ] = method (om_f4, 1.0, {}, info::iterations);           \
+        CHECK(!info.converged);                                                 \
+        CHECK(info.zero_derivative);                                            \
+            auto const                                                          \
+        [ result2, info2 ] = method (om_f3, 1.0, {}, info::iterations);         \
+        CHECK(!info2.converged);                                                \
+        CHECK(info2.function_threw);                                            \
+    }                                                                           \
+}
+
+OPEN_METHOD_TEST_CASE("Secant", secant)
+OPEN_METHOD_TEST_CASE("Steffensen", steffensen)
@@ -0,0 +1,144 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/polynomial.hpp"
+    using namespace calculisto::root_finding;
+
+// (x - 1) (x - 2) (x - 3) (x + 4) (x - 0.5)
+    auto const
+poly5 = std::array { 12., -43., 44.5, -12., -2.5, 1. };
+
+TEST_CASE("Polynomial")
+{
+    SUBCASE("polynomial_real_roots, quadratic")
+    {
+            auto
+        r = polynomial_real_roots (std::array { 2., -3., 1. });
+        CHECK(r.size () == 2);
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 2. });
+        CHECK(polynomial_real_roots (std::array { 1., 0., 1. }).size () == 0);
+    }
+    SUBCASE("polynomial_real_roots, cubic equation of state")
+    {
+        // (x - 0.1) (x - 0.4) (x - 2.5)
+            auto
+        r = polynomial_real_roots (std::array { -0.1, 1.29, -3., 1. });
+        CHECK(r.size () == 3);
+        CHECK(r[0] == doctest::Approx { 0.1 });
+        CHECK(r[1] == doctest::Approx { 0.4 });
+        CHECK(r[2] == doctest::Approx { 2.5 });
+        // x^3 - 1: one real root.
+            auto
+        s = polynomial_real_roots (std::array { -1., 0., 0., 1. });
+        CHECK(s.size () == 1);
+        CHECK(s[0] == doctest::Approx { 1. });
+    }
+    SUBCASE("polynomial_real_roots, quartic")
+    {
+        // (x - 1) (x + 2) (x^2 + 1)
+            auto
+        r = polynomial_real_roots (std::array { -2., 1., -1., 1., 1. });
+        CHECK(r.size () == 2);
+        CHECK(r[0] == doctest::Approx { -2. });
+        CHECK(r[1] == doctest::Approx { 1. });
+        // (x^2 - 1) (x^2 - 4), biquadratic
+            auto
+        s = polynomial_real_roots (std::array { 4., 0., -5., 0., 1. });
+        CHECK(s.size () == 4);
+        CHECK(s[0] == doctest::Approx { -2. });
+        CHECK(s[3] == doctest::Approx { 2. });
+    }
+    SUBCASE("polynomial_roots, Aberth and closed forms agree")
+    {
+        for (auto const& c: {
+              std::array { -2., 1., -1., 1., 1. }
+            , std::array { 24., -50., 35., -10., 1. }
+            , std::array { 1., 2., 3., 4., 5. }
+        }){
+                auto
+            a = polynomial_roots (c, { .closed_form = false });
+            for (auto const& z: polynomial_roots (c))
+            {
+                CHECK(std::ranges::any_of (a, [&](auto w){ return std::abs (z - w) < 1e-10; }));
+            }
+        }
+    }
+    SUBCASE("polynomial_roots, Aberth, std::vector")
+    {
+            auto
+        r = polynomial_real_roots (std::vector (poly5.begin (), poly5.end ()));
+        CHECK(r.size () == 5);
+        CHECK(r[0] == doctest::Approx { -4. });
+        CHECK(r[1] == doctest::Approx { 0.5 });
+        CHECK(r[4] == doctest::Approx { 3. });
+    }
+    SUBCASE("polynomial_roots, zero leading coefficient")
+    {
+        CHECK_THROWS_AS(
+              polynomial_roots (std::array { 1., 1., 0. })
+            , polynomial_zero_leading_coefficient_e
+        );
+        // Not even a polynomial of degree 1.
+        CHECK_THROWS_AS(polynomial_roots (std::vector <double> {}), polynomial_zero_leading_coefficient_e);
+        CHECK_THROWS_AS(polynomial_roots (std::vector { 2. }), polynomial_zero_leading_coefficient_e);
+            auto const
+        [ z, info ] = polynomial_roots (std::vector <double> {}, {}, info::iterations);
+        CHECK(z.empty ());
+        CHECK(!info.converged);
+        CHECK(info.zero_leading_coefficient);
+    }
+    SUBCASE("polynomial_roots, with options")
+    {
+        CHECK_THROWS_AS(
+              polynomial_roots (poly5, { .max_iter = 1 })
+            , polynomial_no_convergence_e
+        );
+    }
+    SUBCASE("polynomial_roots, with info (iteration count)")
+    {
+            auto const
+        [ result, info ] = polynomial_roots (poly5, {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.iteration_count > 1);
+    }
+    SUBCASE("polynomial_roots, with info (convergence)")
+    {
+            auto const
+        [ result, info ] = polynomial_roots (poly5, { .max_iter = 3 }, info::convergence);
+        CHECK(!info.converged);
+        CHECK(info.convergence.size () == 3);
+    }
+    SUBCASE("polynomial_roots, batch")
+    {
+            auto
+        batch = polynomial_batch_t <double, 3> { 100 };
+        for (auto i = 0u; i < batch.size (); ++i)
+        {
+            // (x - 1) (x - a) (x - 2 a)
+                const auto
+            a = 0.1 + 0.05 * i;
+            batch.coefficients[0][i] = -2. * a * a;
+            batch.coefficients[1][i] = 2. * a * a + 3. * a;
+            batch.coefficients[2][i] = -1. - 3. * a;
+            batch.coefficients[3][i] = 1.;
+        }
+            auto const
+        info = polynomial_roots (batch, {}, info::iterations);
+        CHECK(info.converged);
+        for (auto i = 0u; i < batch.size (); ++i)
+        {
+                const auto
+            a = 0.1 + 0.05 * i;
+                auto
+            r = std::array { batch.real[0][i], batch.real[1][i], batch.real[2][i] };
+            std::ranges::sort (r);
+                auto
+            expected = std::array { 1., a, 2. * a };
+            std::ranges::sort (expected);
+            for (auto k = 0u; k < 3; ++k)
+            {
+                CHECK(r[k] == doctest::Approx { expected[k] });
+                CHECK(batch.imag[k][i] == doctest::Approx { 0. });
+            }
+        }
+    }
+}
@@ -3,6 +3,9 @@
 #include "../include/calculisto/root_finding/root_finding.hpp"
     using namespace calculisto::root_finding;
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
     using std::cos, std::sin, std::pow;
 
     namespace 
@@ -147,6 +150,46 @@ TEST_CASE("Newton")
         r = newton (f1, df1, 1.0, { .converged = make_newton_simple_converged (1e-8) });
         CHECK(r == doctest::Approx { target1 });
     }
+    SUBCASE("Backtracking")
+    {
+        // Newton overshoots, further and further, from |x| > 1.39, until the
+        // derivative underflows.
+            auto
+        at = [](double x){ return std::atan (x); };
+            auto
+        dat = [](double x){ return 1 / (1 + x * x); };
+        CHECK_THROWS_AS(newton (at, dat, 3.), newton_zero_derivative_e);
+            auto const
+        [ r, info ] = newton (at, dat, 3., { .backtracking = true }, info::iterations);
+        CHECK(info.converged);
+        CHECK(r == 0.);
+        CHECK(info.backtrack_count > 0);
+        CHECK(info.iteration_count < 10);
+        // Out of the domain, the function throws.
+            auto
+        lg = [](double x){ if (x <= 0) throw std::domain_error { "log" }; return std::log (x) - 1; };
+            auto
+        dlg = [](double x){ return 1 / x; };
+        CHECK_THROWS_AS(newton (lg, dlg, 10.), std::domain_error);
+        CHECK(newton (lg, dlg, 10., { .backtracking = true }) == doctest::Approx { std::numbers::e });
+            auto const
+        [ s, s_info ] = newton (lg, dlg, 10., { .backtracking = true, .max_backtracks = 0 }, info::iterations);
+        CHECK(s_info.function_threw);
+        CHECK(s_info.backtrack_count == 0);
+    }
+    SUBCASE("Bounds")
+    {
+            auto
+        at = [](double x){ return std::atan (x); };
+            auto
+        dat = [](double x){ return 1 / (1 + x * x); };
+        CHECK(newton (at, dat, 3., { .lower = -1, .upper = 1 }) == 0.);
+        // The root is out of the domain.
+            auto const
+        [ r, info ] = newton ([](double x){ return x - 5; }, [](double){ return 1.; }, .5, { .lower = 0, .upper = 1 }, info::iterations);
+        CHECK(!info.converged);
+        CHECK(r == 1.);
+    }
 }
 // -----------------------------------------------------------------------------
 TEST_CASE("Zhang")
@@ -251,6 +294,133 @@ TEST_CASE("Zhang")
         r = zhang (f1, 0.0, 10.0, { .converged = make_zhang_simple_converged (1e-8) });
         CHECK(r == doctest::Approx { target1 });
     }
+    SUBCASE("zhang, bracket beyond 1")
+    {
+        // Around 1260, the bracket can't get narrower than epsilon, and f
+        // has no exact zero: the default criterion is relative there, ...
+            auto
+        f = [](double x){ return x * x * x - 2e9 - 0.3; };
+            auto const
+        [ r, info ] = zhang (f, 1000., 3000., {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(r == doctest::Approx { std::cbrt (2e9 + 0.3) }.epsilon (1e-15));
+        // ... while an absolute one runs to max_iter.
+            auto
+        absolute = [](double a, double b, double fa, double fb)
+        {
+            return fa == 0 || fb == 0 || fabs (b - a) < std::numeric_limits <double>::epsilon ();
+        };
+            auto const
+        [ s, s_info ] = zhang (f, 1000., 3000., { .converged = absolute }, info::iterations);
+        CHECK(!s_info.converged);
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("Constant evaluation")
+{
+        constexpr auto
+    sq = [](double x){ return x * x - 2.; };
+        constexpr auto
+    dsq = [](double x){ return 2. * x; };
+    SUBCASE("newton")
+    {
+            constexpr auto
+        r = newton (sq, dsq, 1.);
+        static_assert (r > 1.4142135623 && r < 1.4142135624);
+            constexpr auto
+        s = newton (sq, dsq, 1., newton_static_options_t <double, double, double> { .max_iter = 1 }, info::iterations);
+        static_assert (!s.second.converged);
+            constexpr auto
+        cvg = make_newton_simple_converged (1e-6);
+            constexpr auto
+        t = newton (sq, dsq, 1., newton_static_options_t <double, double, double, decltype (cvg)> { .converged = cvg });
+        CHECK(t == doctest::Approx { std::numbers::sqrt2 });
+    }
+    SUBCASE("zhang")
+    {
+            constexpr auto
+        r = zhang (sq, 0., 2.);
+        static_assert (r > 1.4142135623 && r < 1.4142135624);
+            constexpr auto
+        s = zhang (sq, 2., 3., zhang_static_options_t <double, double> {}, info::iterations);
+        static_assert (s.second.no_single_root_between_bracket);
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("Bracket root")
+{
+    SUBCASE("bracket_root")
+    {
+            auto const
+        [ a, b, fa, fb ] = bracket_root (f1, 5., 1.);
+        CHECK(a <= target1);
+        CHECK(b >= target1);
+        CHECK(fa == f1 (a));
+        CHECK(fb == f1 (b));
+    }
+    SUBCASE("bracket_root, inward")
+    {
+        // No sign change at the ends of [0.4, 0.42], two roots in between.
+            auto
+        g = [](double x){ return (x - 0.405) * (x - 0.415); };
+            auto const
+        [ a, b, fa, fb ] = bracket_root (g, 0.4, 0.02, { .subdivisions = 4 });
+        CHECK(a <= 0.405);
+        CHECK(b >= 0.405);
+        CHECK(b <= 0.415);
+    }
+    SUBCASE("bracket_root, then zhang, without evaluating the ends again")
+    {
+            auto
+        count = 0;
+            auto
+        counted = [&](double x){ ++count; return f1 (x); };
+            const auto
+        bracket = bracket_root (counted, 5., 1.);
+            const auto
+        bracketing = count;
+            auto const
+        [ r, info ] = zhang (counted, bracket, {}, info::iterations);
+        CHECK(r == doctest::Approx { target1 });
+        CHECK(count - bracketing == 2 * (info.iteration_count + 1));
+    }
+    SUBCASE("bracket_root, then zhang, an end is the root")
+    {
+            auto
+        line = [](double x){ return x - 1; };
+            const auto
+        bracket = bracket_root (line, 1., 0.5);
+        CHECK(std::get <2> (bracket) == 0);
+            auto const
+        [ r, info ] = zhang (line, bracket, {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(r == 1.);
+        CHECK(zhang (line, 1., 3.) == 1.);
+        CHECK(zhang (line, -3., 1.) == 1.);
+    }
+    SUBCASE("bracket_root, throws if no sign change")
+    {
+        CHECK_THROWS_AS(
+              bracket_root ([](double x){ return x * x + 1.; }, 1., 1.)
+            , bracket_root_no_convergence_e
+        );
+    }
+    SUBCASE("bracket_root, user function throws")
+    {
+        CHECK_THROWS_AS(bracket_root (f3, 0., 1.), int);
+            auto const
+        [ r, info ] = bracket_root (f3, 0., 1., {}, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.function_threw);
+    }
+    SUBCASE("bracket_root, with info")
+    {
+            auto const
+        [ r, info ] = bracket_root ([](double x){ return x * x + 1.; }, 1., 1., { .max_iter = 5 }, info::convergence);
+        CHECK(!info.converged);
+        CHECK(info.evaluation_count == 7);
+        CHECK(info.convergence.size () == 6);
+    }
 }
 // -----------------------------------------------------------------------------
     auto
@@ -424,31 +594,195 @@ TEST_CASE("Powel")
         [ r, info ] = powell (rosenbrock, std::valarray { 0.1, 0.1 }, {}, info::convergence);
         CHECK(r[0] == doctest::Approx { 1. });
         CHECK(r[1] == doctest::Approx { 1. });
-        for (auto&& [ i, j, f, p ]: info.convergence)
+        REQUIRE(info.size () > 0);
+        CHECK(info.point (info.size () - 1)[0] == r[0]);
+        CHECK(info.point (info.size () - 1)[1] == r[1]);
+        for (auto k = 0u; k < info.size (); ++k)
         {
-            MESSAGE("iter: ", i, ", direction: ", j, ", f= ", f, ", p= ", p);
-            MESSAGE("Bracket minimum convergence:");
-            for (auto&& [a, b, c]: info.golden_section_info.at (i).bracket_minimum_info.convergence)
+            MESSAGE("iter: ", info.iteration[k], ", direction: ", info.direction[k], ", f= ", info.f[k]
+                , ", p= ", info.point (k)[0], " ", info.point (k)[1]);
+            MESSAGE("Line search:");
+                auto const
+            [ t, ft ] = info.line_search (k);
+            CHECK(info.line_search_converged[k]);
+            CHECK(t.size () > 0);
+            for (auto e = 0u; e < t.size (); ++e)
             {
-                MESSAGE (fmt::format (
-                      "  [{}, {}], [{}, {}], [{}, {}]"
-                    , a.first, a.second
-                    , b.first, b.second
-                    , c.first, c.second
-                ));
+                MESSAGE (fmt::format ("  [{}, {}]", t[e], ft[e]));
             }
-            MESSAGE("Golden section search convergence:");
-            for (auto&& [a, b, c, d]: info.golden_section_info.at (i).convergence)
+        }
+    }
+    SUBCASE("powell, with info (convergence) in an arena")
+    {
+        // Any allocation outside of the buffer throws.
+            static std::byte
+        buffer[1 << 20];
+            auto
+        arena = std::pmr::monotonic_buffer_resource { buffer, sizeof buffer, std::pmr::null_memory_resource () };
+            auto const
+        [ r, info ] = powell (rosenbrock, std::valarray { 0.1, 0.1 }, { .memory_resource = &arena }, info::convergence);
+        CHECK(info.converged);
+        CHECK(info.f.get_allocator ().resource () == &arena);
+        CHECK(r[0] == doctest::Approx { 1. });
+    }
+    SUBCASE("powell, without info")
+    {
+            auto
+        r = powell (rosenbrock, std::valarray { 0.1, 0.1 });
+        CHECK(r[0] == doctest::Approx { 1. });
+        CHECK(r[1] == doctest::Approx { 1. });
+        CHECK_THROWS_AS(
+              powell (rosenbrock, std::valarray { 0.1, 0.1 }, { .max_iter = 1 })
+            , powell_no_convergence_e
+        );
+    }
+    SUBCASE("powell, with info (iteration count)")
+    {
+            auto const
+        [ r, info ] = powell (rosenbrock, std::valarray { 0.1, 0.1 }, {}, info::iterations);
+        CHECK(info.converged);
+        CHECK(info.iteration_count > 1);
+    }
+    SUBCASE("powell, with cache")
+    {
+            auto
+        count = 0;
+            auto
+        counted = [&](std::valarray <double> const& x){ ++count; return rosenbrock (x); };
+            auto const
+        [ r, info ] = powell (counted, std::valarray { 0.1, 0.1 }, {}, info::iterations);
+            const auto
+        uncached = count;
+        count = 0;
+            auto const
+        [ s, cached ] = powell (counted, std::valarray { 0.1, 0.1 }, { .cache = true }, info::iterations);
+        CHECK(s[0] == r[0]);
+        CHECK(s[1] == r[1]);
+        CHECK(cached.cache_hits > 0);
+        CHECK(cached.cache_misses == count);
+        CHECK(count + cached.cache_hits == uncached);
+    }
+    SUBCASE("powell, with a budget")
+    {
+            const auto
+        init = std::valarray { 0.1, 0.1 };
+            auto
+        count = 0;
+            auto
+        counted = [&](std::valarray <double> const& x){ ++count; return rosenbrock (x); };
+            auto const
+        [ r, info ] = powell (counted, std::valarray (init), { .budget = { .max_evaluations = 50 } }, info::iterations);
+        CHECK(!info.converged);
+        CHECK(info.budget_exhausted);
+        CHECK(!info.function_threw);
+        CHECK(info.evaluation_count == 50);
+        CHECK(count == 50);
+        CHECK(rosenbrock (r) < rosenbrock (init));
+            auto const
+        [ s, sinfo ] = powell (rosenbrock, std::valarray (init), { .budget = { .max_evaluations = 50 } }, info::convergence);
+        CHECK(sinfo.budget_exhausted);
+        CHECK(s[0] == r[0]);
+        CHECK(s[1] == r[1]);
+            auto const
+        [ t, tinfo ] = powell (rosenbrock, std::valarray (init), {}, info::iterations);
+        CHECK(tinfo.converged);
+        CHECK(!tinfo.budget_exhausted);
+        CHECK(tinfo.evaluation_count > 50);
+    }
+    SUBCASE("powell, cancelled, past the deadline")
+    {
+            auto
+        token = cancellation_token_t {};
+        token.cancel ();
+            auto const
+        [ r, info ] = powell (rosenbrock, std::valarray { 0.1, 0.1 }, { .budget = { .cancellation = &token } }, info::iterations);
+        CHECK(info.budget_exhausted);
+        CHECK(info.evaluation_count == 0);
+        CHECK(r[0] == 0.1);
+            auto const
+        [ s, sinfo ] = powell (
+              rosenbrock
+            , std::valarray { 0.1, 0.1 }
+            , { .budget = { .deadline = std::chrono::steady_clock::now () } }
+            , info::iterations
+        );
+        CHECK(sinfo.budget_exhausted);
+    }
+    SUBCASE("powell, with a budget, without info")
+    {
+        try
+        {
+            powell (rosenbrock, std::valarray { 0.1, 0.1 }, { .budget = { .max_evaluations = 50 } });
+            CHECK(false);
+        }
+        catch (powell_budget_exhausted_e <double, double> const& e)
+        {
+            CHECK(e.f_best == rosenbrock (e.best));
+            CHECK(e.f_best < rosenbrock (std::valarray { 0.1, 0.1 }));
+        }
+    }
+    SUBCASE("evaluation_cache_t")
+    {
+            auto
+        count = 0;
+            auto
+        f = [&](double x){ ++count; return x * x; };
+            auto
+        cache = evaluation_cache_t <double, double, 4> {};
+            auto
+        cached = make_cached (f, cache);
+        for (auto x: { 1., 2., 1., 2., 3., 1. })
+        {
+            CHECK(cached (x) == x * x);
+        }
+        CHECK(cache.hits == 3);
+        CHECK(cache.misses == 3);
+        CHECK(count == 3);
+    }
+    SUBCASE("evaluation_cache_t, full probes")
+    {
+        // The home slot of x, in a table of 8, as the cache computes it.
+            auto
+        home = [](double x)
+        {
+                std::uint64_t
+            hash = 14695981039346656037ull;
+                unsigned char
+            bytes[sizeof x];
+            std::memcpy (bytes, &x, sizeof x);
+            for (auto b: bytes)
+            {
+                hash = (hash ^ b) * 1099511628211ull;
+            }
+            return hash & 7;
+        };
+        // Five keys with the same home: the fifth one evicts the first.
+            auto
+        keys = std::vector <double> {};
+        for (auto x = 1.; keys.size () < 5; ++x)
+        {
+            if (home (x) == home (1.))
             {
-                MESSAGE (fmt::format (
-                      "  [{}, {}], [{}, {}], [{}, {}], [{}, {}]"
-                      , a.first, a.second
-                      , c.first, c.second
-                      , d.first, d.second
-                      , b.first, b.second
-                ));
+                keys.push_back (x);
             }
         }
-
+            auto
+        f = [](double x){ return x * x; };
+            auto
+        cache = evaluation_cache_t <double, double, 8> {};
+        for (auto x: keys)
+        {
+            cache (f, x);
+        }
+        CHECK(cache.misses == 5);
+        CHECK(cache (f, keys[4]) == keys[4] * keys[4]);
+        CHECK(cache.hits == 1);
+        for (auto i = 1u; i < 4; ++i)
+        {
+            cache (f, keys[i]);
+        }
+        CHECK(cache.hits == 4);
+        cache (f, keys[0]);
+        CHECK(cache.misses == 6);
     }
 }
@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+#include "../include/calculisto/root_finding/statistics.hpp"
+#include "../include/calculisto/root_finding/fixed_point.hpp"
+#include "../include/calculisto/root_finding/levenberg_marquardt.hpp"
+    using namespace calculisto::root_finding;
+#include <cmath>
+
+    namespace
+{
+        auto
+    st_f = [](double x){ return std::cos (x) - x * x * x; };
+        auto
+    st_df = [](double x){ return -std::sin (x) - 3 * x * x; };
+}
+
+TEST_CASE("Statistics")
+{
+    SUBCASE("solve_statistics_t::quantile")
+    {
+            auto
+        h = solve_statistics_t::histogram_t {};
+        h[0] = 1; // 0
+        h[3] = 8; // [4, 8)
+        h[5] = 1; // [16, 32)
+        CHECK(solve_statistics_t::quantile (h, 0.) == 0);
+        CHECK(solve_statistics_t::quantile (h, 0.5) == 7);
+        CHECK(solve_statistics_t::quantile (h, 0.9) == 7);
+        CHECK(solve_statistics_t::quantile (h, 1.) == 31);
+        CHECK(solve_statistics_t::quantile ({}, 0.5) == 0);
+    }
+    SUBCASE("From the info of the solvers")
+    {
+            auto
+        sink = statistics_sink_t {};
+            auto const
+        [ r, info ] = record_solve (sink, [&]{ return zhang (st_f, 0., 10., {}, info::iterations); });
+        CHECK(info.converged);
+        record_solve (sink, [&]{ return zhang (st_f, 0., 0.1, {}, info::iterations); });
+        record_solve (sink, [&]{ return newton (st_f, [](double){ return 0.; }, 1., {}, info::convergence); });
+        record_solve (sink, [&]{ return newton (
+              [](double) -> double { throw 0; }
+            , st_df
+            , 1.
+            , {}
+            , info::iterations
+        ); });
+        record_solve (sink, [&]{ return fixed_point ([](double x){ return std::cos (x); }, 1., {}, info::iterations); });
+            const auto
+        s = sink.snapshot ();
+        CHECK(s.solves == 5);
+        CHECK(s.converged == 2);
+        CHECK(s.no_single_root_between_bracket == 1);
+        CHECK(s.zero_derivative == 1);
+        CHECK(s.function_threw == 1);
+            std::uint64_t
+          iterations = 0
+        , evaluations = 0
+        , durations = 0
+        ;
+        for (auto k = 0u; k < solve_statistics_t::buckets; ++k)
+        {
+            iterations += s.iterations[k];
+            evaluations += s.evaluations[k];
+            durations += s.nanoseconds[k];
+        }
+        CHECK(iterations == 5);
+        CHECK(evaluations == 1);
+        CHECK(durations == 5);
+        CHECK(solve_statistics_t::quantile (s.iterations, 1.) >= static_cast <std::uint64_t> (info.iteration_count));
+    }
+    SUBCASE("From a convergence info")
+    {
+            auto
+        sink = statistics_sink_t {};
+            auto const
+        [ x, info ] = record_solve (sink, [&]{ return levenberg_marquardt (
+              [](auto const& p, auto& r){ r[0] = p[0] - 1; r[1] = 10 * (p[1] - p[0] * p[0]); }
+            , std::array { -1.2, 1. }
+            , 2
+            , {}
+            , info::convergence
+        ); });
+        REQUIRE(info.convergence.size () > 1);
+            const auto
+        s = sink.snapshot ();
+        // Its iterations are its history, not the iteration_count it leaves
+        // at 0.
+        CHECK(s.iterations[0] == 0);
+        CHECK(solve_statistics_t::quantile (s.iterations, 1.) >= info.convergence.size ());
+    }
+    SUBCASE("From many threads")
+    {
+            auto
+        sink = statistics_sink_t { 3 };
+            const auto
+        n = 1000u;
+        parallel_for (n, 8, [&](std::size_t i)
+        {
+            record_solve (sink, [&]{ return zhang (st_f, 0., 1. + static_cast <double> (i % 10), {}, info::iterations); });
+        });
+            const auto
+        s = sink.snapshot ();
+        CHECK(s.solves == n);
+        CHECK(s.converged == n);
+    }
+}